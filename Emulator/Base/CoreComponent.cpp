@@ -253,13 +253,13 @@ CoreComponent::size(bool recursive)
 }
 
 isize
-CoreComponent::load(const u8 *buffer)
+CoreComponent::load(const u8 *buffer, bool verify)
 {
     assert(!isRunning());
 
     isize result = 0;
 
-    postorderWalk([this, buffer, &result](CoreComponent *c) {
+    postorderWalk([this, buffer, verify, &result](CoreComponent *c) {
 
         const u8 *ptr = buffer + result;
 
@@ -273,7 +273,7 @@ CoreComponent::load(const u8 *buffer)
         isize count = (isize)(reader.ptr - (buffer + result));
 
         // Check integrity
-        if (hash != c->checksum(false) || FORCE_SNAP_CORRUPTED) {
+        if ((verify && hash != c->checksum(false)) || FORCE_SNAP_CORRUPTED) {
             if (SNP_DEBUG) { fatalError; } else { throw Error(ERROR_SNAP_CORRUPTED); }
         }
 
@@ -287,29 +287,35 @@ CoreComponent::load(const u8 *buffer)
 }
 
 isize
-CoreComponent::save(u8 *buffer)
+CoreComponent::save(u8 *buffer, bool checksums)
 {
     isize result = 0;
 
-    postorderWalk([this, buffer, &result](CoreComponent *c) {
+    postorderWalk([buffer, checksums, &result](CoreComponent *c) {
 
-        u8 *ptr = buffer + result;
+        result += c->saveComponent(buffer + result, checksums);
+    });
 
-        // Save the checksum for this component
-        write64(ptr, c->checksum(false));
+    postorderWalk([](CoreComponent *c) { c->_didSave(); });
 
-        // Save the internal state of this component
-        SerWriter writer(ptr); *c << writer;
+    return result;
+}
 
-        // Determine the number of written bytes
-        isize count = (isize)(writer.ptr - (buffer + result));
+isize
+CoreComponent::save(std::function<void(const u8 *, isize)> func)
+{
+    util::Buffer<u8> buffer;
+    isize result = 0;
 
-        // Check integrity
-        if (count != c->size(false) || FORCE_SNAP_CORRUPTED) {
-            if (SNP_DEBUG) { fatalError; } else { throw Error(ERROR_SNAP_CORRUPTED); }
-        }
+    postorderWalk([&buffer, &result, &func](CoreComponent *c) {
+
+        // Serialize the component into a temporary buffer
+        auto size = c->size(false);
+        if (buffer.size < size) buffer.alloc(size);
+        auto count = c->saveComponent(buffer.ptr);
 
-        debug(SNP_DEBUG, "Saved %ld bytes (expected %ld)\n", count, c->size(false));
+        // Hand the data over to the caller
+        func(buffer.ptr, count);
         result += count;
     });
 
@@ -318,6 +324,29 @@ CoreComponent::save(u8 *buffer)
     return result;
 }
 
+isize
+CoreComponent::saveComponent(u8 *buffer, bool checksums)
+{
+    u8 *ptr = buffer;
+
+    // Save the checksum for this component (zero if omitted)
+    write64(ptr, checksums ? checksum(false) : 0);
+
+    // Save the internal state of this component
+    SerWriter writer(ptr); *this << writer;
+
+    // Determine the number of written bytes
+    isize count = (isize)(writer.ptr - buffer);
+
+    // Check integrity
+    if (count != size(false) || FORCE_SNAP_CORRUPTED) {
+        if (SNP_DEBUG) { fatalError; } else { throw Error(ERROR_SNAP_CORRUPTED); }
+    }
+
+    debug(SNP_DEBUG, "Saved %ld bytes (expected %ld)\n", count, size(false));
+    return count;
+}
+
 std::vector<CoreComponent *> 
 CoreComponent::collectComponents()
 {
@@ -186,13 +186,21 @@ public:
     void softReset() { reset(false); }
 
     // Loads the internal state from a memory buffer
-    isize load(const u8 *buf) throws;
+    isize load(const u8 *buf, bool verify = true) throws;
     virtual void _didLoad() { }
 
     // Saves the internal state to a memory buffer
-    isize save(u8 *buf);
+    isize save(u8 *buf, bool checksums = true);
     virtual void _didSave() { }
 
+    // Saves the internal state component by component
+    isize save(std::function<void(const u8 *, isize)> func);
+
+private:
+
+    // Saves the internal state of this component (without subcomponents)
+    isize saveComponent(u8 *buf, bool checksums = true);
+
 
     //
     // Working with subcomponents
@@ -30,6 +30,8 @@ Defaults::Defaults()
     setFallback(OPT_AMIGA_SNAPSHOTS,            false);
     setFallback(OPT_AMIGA_SNAPSHOT_DELAY,       10);
     setFallback(OPT_AMIGA_RUN_AHEAD,            0);
+    setFallback(OPT_AMIGA_REWIND,               0);
+    setFallback(OPT_AMIGA_REWIND_BUDGET,        64);
 
     setFallback(OPT_AGNUS_REVISION,             AGNUS_ECS_1MB);
     setFallback(OPT_AGNUS_PTR_DROPS,            true);
@@ -119,6 +121,8 @@ Defaults::Defaults()
     setFallback(OPT_DENISE_CLX_SPR_PLF,         false);
     setFallback(OPT_DENISE_CLX_PLF_PLF,         false);
 
+    setFallback(OPT_COPPER_REPLAY,              false);
+
     setFallback(OPT_BLITTER_ACCURACY,           2);
 
     setFallback(OPT_CIA_REVISION,               CIA_MOS_8520_DIP,       { 0, 1} );
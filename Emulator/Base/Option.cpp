@@ -38,6 +38,8 @@ OptionParser::create(Option opt, i64 arg)
         case OPT_AMIGA_SNAPSHOTS:           return boolParser();
         case OPT_AMIGA_SNAPSHOT_DELAY:      return numParser(" sec");
         case OPT_AMIGA_RUN_AHEAD:           return numParser(" frames");
+        case OPT_AMIGA_REWIND:              return numParser(" sec");
+        case OPT_AMIGA_REWIND_BUDGET:       return numParser(" MB");
 
         case OPT_AGNUS_REVISION:            return enumParser.template operator()<AgnusRevisionEnum>();
         case OPT_AGNUS_PTR_DROPS:           return boolParser();
@@ -124,6 +126,8 @@ OptionParser::create(Option opt, i64 arg)
         case OPT_SER_DEVICE:                return enumParser.template operator()<SerialPortDeviceEnum>();
         case OPT_SER_VERBOSE:               return boolParser();
 
+        case OPT_COPPER_REPLAY:             return boolParser();
+
         case OPT_BLITTER_ACCURACY:          return numParser();
 
         case OPT_CIA_REVISION:              return enumParser.template operator()<CIARevisionEnum>();
@@ -33,6 +33,8 @@ enum_long(OPT)
     OPT_AMIGA_SNAPSHOTS,        ///< Automatically take a snapshots
     OPT_AMIGA_SNAPSHOT_DELAY,   ///< Delay between two snapshots in seconds
     OPT_AMIGA_RUN_AHEAD,        ///< Number of run-ahead frames
+    OPT_AMIGA_REWIND,           ///< Length of the rewind buffer in seconds
+    OPT_AMIGA_REWIND_BUDGET,    ///< Memory budget of the rewind buffer in MB
 
     // Agnus
     OPT_AGNUS_REVISION,
@@ -133,6 +135,9 @@ enum_long(OPT)
     OPT_SER_DEVICE,
     OPT_SER_VERBOSE,
 
+    // Copper
+    OPT_COPPER_REPLAY,
+
     // Blitter
     OPT_BLITTER_ACCURACY,
 
@@ -206,6 +211,8 @@ struct OptionEnum : vamiga::util::Reflection<OptionEnum, Option>
             case OPT_AMIGA_SNAPSHOTS:           return "AMIGA.SNAPSHOTS";
             case OPT_AMIGA_SNAPSHOT_DELAY:      return "AMIGA.SNAPSHOT_DELAY";
             case OPT_AMIGA_RUN_AHEAD:           return "AMIGA.RUN_AHEAD";
+            case OPT_AMIGA_REWIND:              return "AMIGA.REWIND";
+            case OPT_AMIGA_REWIND_BUDGET:       return "AMIGA.REWIND_BUDGET";
 
             case OPT_AGNUS_REVISION:            return "AGNUS.REVISION";
             case OPT_AGNUS_PTR_DROPS:           return "AGNUS.PTR_DROPS";
@@ -292,6 +299,8 @@ struct OptionEnum : vamiga::util::Reflection<OptionEnum, Option>
             case OPT_SER_DEVICE:                return "SER.DEVICE";
             case OPT_SER_VERBOSE:               return "SER.VERBOSE";
 
+            case OPT_COPPER_REPLAY:             return "COPPER.REPLAY";
+
             case OPT_BLITTER_ACCURACY:          return "BLITTER.ACCURACY";
 
             case OPT_CIA_REVISION:              return "CIA.REVISION";
@@ -351,6 +360,8 @@ struct OptionEnum : vamiga::util::Reflection<OptionEnum, Option>
             case OPT_AMIGA_SNAPSHOTS:           return "Automatically take snapshots";
             case OPT_AMIGA_SNAPSHOT_DELAY:      return "Time span between two snapshots";
             case OPT_AMIGA_RUN_AHEAD:           return "Run-ahead frames";
+            case OPT_AMIGA_REWIND:              return "Rewind buffer length";
+            case OPT_AMIGA_REWIND_BUDGET:       return "Rewind buffer size";
 
             case OPT_AGNUS_REVISION:            return "Chip revision";
             case OPT_AGNUS_PTR_DROPS:           return "Ignore certain register writes";
@@ -437,6 +448,8 @@ struct OptionEnum : vamiga::util::Reflection<OptionEnum, Option>
             case OPT_SER_DEVICE:                return "Serial device type";
             case OPT_SER_VERBOSE:               return "Verbose";
 
+            case OPT_COPPER_REPLAY:             return "Replay static Copper lists";
+
             case OPT_BLITTER_ACCURACY:          return "Blitter accuracy level";
 
             case OPT_CIA_REVISION:              return "Chip revision";
@@ -15,6 +15,7 @@
 #include "RingBuffer.h"
 #include <cassert>
 #include <concepts>
+#include <functional>
 #include <vector>
 
 namespace vamiga {
@@ -118,6 +119,19 @@ inline void writeString(u8 *& buf, string value)
 }
 
 
+/* A byte sequence that is serialized in the same format as Allocator<u8>,
+ * but isn't stored in a contiguous buffer. When the state is saved, the
+ * bytes are requested range by range from 'source'. When the state is
+ * restored, the serialized bytes are handed over to 'sink' in one piece.
+ */
+struct ByteStream {
+
+    isize size = 0;
+    std::function<void(u8 *dst, isize offset, isize len)> source;
+    std::function<void(const u8 *src, isize len)> sink;
+};
+
+
 //
 // Counter (determines the state size)
 //
@@ -139,8 +153,9 @@ class SerCounter
 public:
 
     isize count;
+    bool bulk;
 
-    SerCounter() { count = 0; }
+    SerCounter(bool bulk = true) : bulk(bulk) { count = 0; }
 
     COUNT8(const bool)
     COUNT8(const char)
@@ -164,6 +179,12 @@ public:
         return *this;
     }
 
+    auto& operator<<(ByteStream &s)
+    {
+        count += 8 + s.size;
+        return *this;
+    }
+
     template <class T, isize N>
     auto& operator<<(util::Array<T, N> &a)
     {
@@ -289,6 +310,23 @@ public:
         return *this;
     }
 
+    auto& operator<<(ByteStream &s)
+    {
+        // Hash the bytes chunk by chunk as Allocator<u8>::fnv64() would do
+        u8 chunk[4096];
+        u64 h = s.size ? util::fnvInit64() : 0;
+
+        for (isize offset = 0; offset < s.size; offset += isizeof(chunk)) {
+
+            isize len = std::min(isizeof(chunk), s.size - offset);
+            s.source(chunk, offset, len);
+            for (isize i = 0; i < len; i++) h = util::fnvIt64(h, chunk[i]);
+        }
+
+        hash = util::fnvIt64(hash, h);
+        return *this;
+    }
+
     template <class T, isize N>
     auto& operator<<(util::Array<T, N> &a)
     {
@@ -395,8 +433,9 @@ class SerReader
 public:
 
     const u8 *ptr;
+    bool bulk;
 
-    SerReader(const u8 *p) : ptr(p) { }
+    SerReader(const u8 *p, bool bulk = true) : ptr(p), bulk(bulk) { }
 
     DESERIALIZE8(bool)
     DESERIALIZE8(char)
@@ -423,6 +462,15 @@ public:
         return *this;
     }
 
+    auto& operator<<(ByteStream &s)
+    {
+        i64 len;
+        *this << len;
+        s.sink(ptr, isize(len));
+        ptr += len;
+        return *this;
+    }
+
     template <class T, isize N>
     auto& operator<<(util::Array<T, N> &a)
     {
@@ -542,8 +590,9 @@ class SerWriter
 public:
 
     u8 *ptr;
+    bool bulk;
 
-    SerWriter(u8 *p) : ptr(p) { }
+    SerWriter(u8 *p, bool bulk = true) : ptr(p), bulk(bulk) { }
 
     SERIALIZE8(const bool)
     SERIALIZE8(const char)
@@ -569,6 +618,14 @@ public:
         return *this;
     }
 
+    auto& operator<<(ByteStream &s)
+    {
+        *this << i64(s.size);
+        s.source(ptr, 0, s.size);
+        ptr += s.size;
+        return *this;
+    }
+
     template <class T, isize N>
     auto& operator<<(util::Array<T, N> &a)
     {
@@ -704,6 +761,11 @@ public:
         return *this;
     }
 
+    auto& operator<<(ByteStream &s)
+    {
+        return *this;
+    }
+
     template <class T, isize N>
     auto& operator<<(util::Array<T, N> &a)
     {
@@ -789,6 +851,16 @@ template <> inline bool isSoftResetter(SerResetter &worker) { return worker.isSo
 template <class T> inline bool isHardResetter(T &worker) { return false; }
 template <> inline bool isHardResetter(SerResetter &worker) { return worker.isHard(); }
 
+/* Counters, readers, and writers can be instructed to skip bulk data, i.e.,
+ * memory contents and the data of inserted disks. The rewinder uses this mode
+ * to serialize the component state separately from the bulk data which it
+ * tracks via modification stamps.
+ */
+template <class T> inline bool skipsBulkData(T &worker) { return false; }
+template <> inline bool skipsBulkData(SerCounter &worker) { return !worker.bulk; }
+template <> inline bool skipsBulkData(SerReader &worker) { return !worker.bulk; }
+template <> inline bool skipsBulkData(SerWriter &worker) { return !worker.bulk; }
+
 }
 
 #define SERIALIZERS(fn) \
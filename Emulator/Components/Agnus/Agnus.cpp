@@ -224,7 +224,27 @@ Agnus::execute()
 void
 Agnus::execute(DMACycle cycles)
 {
-    for (DMACycle i = 0; i < cycles; i++) execute();
+    /* Between two events, executing Agnus only advances the clock and the
+     * horizontal counter. Hence, we can skip all cycles up to the next
+     * trigger cycle in a single step. Line wraps are no special case, because
+     * the horizontal counter is only reset inside an event handler.
+     */
+    while (cycles > 0) {
+
+        // Determine how many cycles can be skipped without missing an event
+        DMACycle skip = cycles;
+        if (nextTrigger <= clock + DMA_CYCLES(cycles)) {
+            skip = std::max(DMACycle(1), AS_DMA_CYCLES(nextTrigger - clock + DMA_CYCLES(1) - 1));
+        }
+
+        // Advance the internal clock and the horizontal counter
+        clock += DMA_CYCLES(skip);
+        pos.h += skip;
+        cycles -= skip;
+
+        // Process pending events
+        if (nextTrigger <= clock) executeUntil(clock);
+    }
 }
 
 void
@@ -612,6 +632,9 @@ Agnus::eolHandler()
     // Pass control to the DMA debugger
     dmaDebugger.eolHandler();
 
+    // Update memory statistics
+    mem.eolHandler();
+
     // Move to the next line
     pos.eol();
 
@@ -297,8 +297,8 @@ Agnus::serviceREGEvent(Cycle until)
         }
     }
 
-    // Schedule next event
-    scheduleNextREGEvent();
+    // Schedule the next event or idle until the next change gets recorded
+    scheduleAbs<SLOT_REG>(changeRecorder.trigger(), REG_CHANGE);
 }
 
 #define LO_NONE(x)      { serviceBPLEventLores<x>(); }
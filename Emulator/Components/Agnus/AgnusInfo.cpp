@@ -206,6 +206,7 @@ Agnus::eventName(EventSlot slot, EventID id)
                 case COP_JMP1:         return "COP_JMP1";
                 case COP_JMP2:         return "COP_JMP2";
                 case COP_VBLANK:       return "COP_VBLANK";
+                case COP_REPLAY:       return "COP_REPLAY";
                 default:               return "*** INVALID ***";
             }
             break;
@@ -271,6 +271,7 @@ enum_i8(EventID)
     COP_JMP1,
     COP_JMP2,
     COP_VBLANK,
+    COP_REPLAY,
     COP_EVENT_COUNT,
     
     // Blitter slot
@@ -33,6 +33,7 @@ namespace vamiga {
 class Blitter : public SubComponent, public Inspectable<BlitterInfo>
 {
     friend class Agnus;
+    friend class RegressionTester;
 
     Descriptions descriptions = {{
 
@@ -479,12 +480,62 @@ public:
 private:
     
     // Emulates the barrel shifter
-    u16 barrelShifter(u16 anew, u16 aold, u16 shift, bool desc = false) const;
+    u16 barrelShifter(u16 anew, u16 aold, u16 shift, bool desc = false) const {
+        return desc ?
+        (u16)(HI_W_LO_W(anew, aold) >> (16 - shift)) :
+        (u16)(HI_W_LO_W(aold, anew) >> shift);
+    }
     
     // Emulates the minterm logic circuit
     u16 doMintermLogic     (u16 a, u16 b, u16 c, u8 minterm) const;
-    u16 doMintermLogicQuick(u16 a, u16 b, u16 c, u8 minterm) const;
-    
+    u16 doMintermLogicQuick(u16 a, u16 b, u16 c, u8 minterm) const {
+        return mintermFunc[minterm](a, b, c);
+    }
+
+    /* Emulates the minterm logic circuit for a fixed minterm. The function
+     * is specialized at compile time by expanding the truth table variable
+     * by variable (A, B, C). Constant or duplicate halves are folded away,
+     * which reduces most minterms to one or two logical operations.
+     */
+    template <u8 minterm, isize n = 3>
+    static u16 applyMinterm(u16 a, u16 b, u16 c) {
+
+        if constexpr (n == 0) {
+
+            return minterm ? 0xFFFF : 0x0000;
+
+        } else {
+
+            constexpr isize w = 1 << (n - 1);
+            constexpr u8 ones = u8((1 << w) - 1);
+            constexpr u8 hi = u8(minterm >> w);
+            constexpr u8 lo = u8(minterm & ones);
+            u16 x = n == 3 ? a : n == 2 ? b : c;
+
+            if constexpr (hi == lo) {
+                return applyMinterm<hi, n - 1>(a, b, c);
+            } else if constexpr (lo == 0) {
+                return u16(x & applyMinterm<hi, n - 1>(a, b, c));
+            } else if constexpr (hi == 0) {
+                return u16(~x & applyMinterm<lo, n - 1>(a, b, c));
+            } else if constexpr (hi == ones) {
+                return u16(x | applyMinterm<lo, n - 1>(a, b, c));
+            } else if constexpr (lo == ones) {
+                return u16(~x | applyMinterm<hi, n - 1>(a, b, c));
+            } else if constexpr (hi == (lo ^ ones)) {
+                return u16(~(x ^ applyMinterm<hi, n - 1>(a, b, c)));
+            } else {
+                u16 h = applyMinterm<hi, n - 1>(a, b, c);
+                u16 l = applyMinterm<lo, n - 1>(a, b, c);
+                return u16(l ^ ((l ^ h) & x));
+            }
+        }
+    }
+
+    // Lookup table with a specialized minterm function for each minterm
+    typedef u16 (*MintermFunc)(u16, u16, u16);
+    static const std::array<MintermFunc, 256> mintermFunc;
+
     // Emulates the fill logic circuit
     void doFill(u16 &data, bool &carry) const;
     
@@ -526,6 +577,14 @@ private:
     // Performs a copy blit operation via the FastBlitter
     template <bool useA, bool useB, bool useC, bool useD, bool desc>
     void doFastCopyBlit();
+
+    // Performs a copy blit operation directly on Chip Ram (if possible)
+    bool doRawCopyBlit();
+    template <bool desc, u8 minterm>
+    void doRawCopyBlit(u8 *a, u8 *b, u8 *c, u8 *d);
+
+    // Translates a channel pointer into a Chip Ram pointer (if possible)
+    u8 *rawChipPtr(u32 pt, i16 mod, bool desc, u32 &first, u32 &last) const;
     
     // Performs a line blit operation via the FastBlitter
     void doFastLineBlit();
@@ -49,8 +49,11 @@ Blitter::beginFastCopyBlit()
     assert(!bltconLINE());
 
     // Run the fast copy Blitter
-    isize nr = ((bltcon0 >> 7) & 0b11110) | (bltconDESC() ? 1 : 0);
-    (this->*blitfunc[nr])();
+    if (!doRawCopyBlit()) {
+
+        isize nr = ((bltcon0 >> 7) & 0b11110) | (bltconDESC() ? 1 : 0);
+        (this->*blitfunc[nr])();
+    }
 
     // Terminate immediately
     clearBusyFlag();
@@ -90,6 +93,9 @@ void Blitter::doFastCopyBlit()
     i32 cmod = desc ? -bltcmod : bltcmod;
     i32 dmod = desc ? -bltdmod : bltdmod;
 
+    // Look up the minterm function
+    auto minterm = mintermFunc[bltcon0 & 0xFF];
+
     aold = 0;
     bold = 0;
 
@@ -138,7 +144,7 @@ void Blitter::doFastCopyBlit()
             }
             
             // Run the minterm circuit
-            dhold = doMintermLogic(ahold, bhold, chold, bltcon0 & 0xFF);
+            dhold = minterm(ahold, bhold, chold);
 
             // Run the fill logic circuit
             if (fill) doFill(dhold, fillCarry);
@@ -177,6 +183,161 @@ void Blitter::doFastCopyBlit()
     bltdpt = dpt;
 }
 
+bool
+Blitter::doRawCopyBlit()
+{
+    /* This function is the fast path of the FastBlitter. It is taken if all
+     * enabled channels stay inside a single Chip Ram mirror for the whole
+     * blit. In this case, the blit operates on raw memory pointers and the
+     * per-word memory source lookups are avoided. In addition, the blit
+     * loop is specialized for the selected minterm which is looked up only
+     * once per blit.
+     */
+
+    // Debugging requires the word-by-word path
+    if (BLT_DEBUG || BLT_CHECKSUM) return false;
+
+    bool desc = bltconDESC();
+    u32 first, last, dFirst = 0, dLast = 0;
+    u8 *a = nullptr, *b = nullptr, *c = nullptr, *d = nullptr;
+
+    // Translate the channel pointers
+    if (bltconUSEA() && !(a = rawChipPtr(bltapt, bltamod, desc, first, last))) return false;
+    if (bltconUSEB() && !(b = rawChipPtr(bltbpt, bltbmod, desc, first, last))) return false;
+    if (bltconUSEC() && !(c = rawChipPtr(bltcpt, bltcmod, desc, first, last))) return false;
+    if (bltconUSED() && !(d = rawChipPtr(bltdpt, bltdmod, desc, dFirst, dLast))) return false;
+
+    // Instantiate a specialized blit function for each minterm
+    static constexpr auto rawblitfunc = []<std::size_t... i>(std::index_sequence<i...>) {
+        return std::array { &Blitter::doRawCopyBlit<bool(i & 1), u8(i >> 1)>... };
+    }(std::make_index_sequence<512>());
+
+    // Perform the blit
+    (this->*rawblitfunc[(bltcon0 & 0xFF) << 1 | desc])(a, b, c, d);
+
+    // Inform the memory about the modified pages
+    if (d) mem.touchChip(dFirst, dLast);
+
+    return true;
+}
+
+template <bool desc, u8 minterm> void
+Blitter::doRawCopyBlit(u8 *a, u8 *b, u8 *c, u8 *d)
+{
+    u8 *a0 = a, *b0 = b, *c0 = c, *d0 = d;
+
+    bool fill = bltconFE();
+    bool fillCarry;
+    u16 ash = bltconASH();
+    u16 bsh = bltconBSH();
+
+    constexpr isize incr = desc ? -2 : 2;
+    isize amod = desc ? -bltamod : bltamod;
+    isize bmod = desc ? -bltbmod : bltbmod;
+    isize cmod = desc ? -bltcmod : bltcmod;
+    isize dmod = desc ? -bltdmod : bltdmod;
+
+    // Cache the Blitter registers in local variables
+    u16 anew = this->anew, bnew = this->bnew;
+    u16 ahold = this->ahold, bhold = this->bhold, chold = this->chold, dhold = this->dhold;
+    u16 aold = 0, bold = 0;
+    u16 bus = mem.dataBus;
+    bool zero = bzero;
+
+    for (isize y = 0; y < bltsizeV; y++) {
+
+        // Reset the fill carry bit
+        fillCarry = !!bltconFCI();
+
+        // Apply the "first word mask" in the first iteration
+        u16 mask = bltafwm;
+
+        for (isize x = 0; x < bltsizeH; x++) {
+
+            // Apply the "last word mask" in the last iteration
+            if (x == bltsizeH - 1) mask &= bltalwm;
+
+            // Fetch A, B, and C
+            if (a) { bus = anew = R16BE(a); a += incr; }
+            if (b) { bus = bnew = R16BE(b); b += incr; }
+            if (c) { bus = chold = R16BE(c); c += incr; }
+
+            // Run the barrel shifters
+            ahold = barrelShifter(anew & mask, aold, ash, desc);
+            aold = anew & mask;
+
+            if (b) {
+                bhold = barrelShifter(bnew, bold, bsh, desc);
+                bold = bnew;
+            }
+
+            // Run the minterm circuit
+            dhold = applyMinterm<minterm>(ahold, bhold, chold);
+
+            // Run the fill logic circuit
+            if (fill) doFill(dhold, fillCarry);
+
+            // Update the zero flag
+            if (dhold) zero = false;
+
+            // Write D
+            if (d) { W16BE(d, dhold); bus = dhold; d += incr; }
+
+            // Clear the word mask
+            mask = 0xFFFF;
+        }
+
+        // Add modulo values
+        if (a) a += amod;
+        if (b) b += bmod;
+        if (c) c += cmod;
+        if (d) d += dmod;
+    }
+
+    // Write back the cached registers
+    this->anew = anew;
+    this->bnew = bnew;
+    this->aold = aold;
+    this->bold = bold;
+    this->ahold = ahold;
+    this->bhold = bhold;
+    this->chold = chold;
+    this->dhold = dhold;
+    mem.dataBus = bus;
+    bzero = zero;
+
+    // Write back pointer registers
+    if (a) bltapt = U32_ADD(bltapt, a - a0);
+    if (b) bltbpt = U32_ADD(bltbpt, b - b0);
+    if (c) bltcpt = U32_ADD(bltcpt, c - c0);
+    if (d) bltdpt = U32_ADD(bltdpt, d - d0);
+}
+
+u8 *
+Blitter::rawChipPtr(u32 pt, i16 mod, bool desc, u32 &first, u32 &last) const
+{
+    // Compute the start address of the first and the last row
+    i64 stride = 2 * i64(bltsizeH) + mod;
+    i64 row1 = pt;
+    i64 row2 = desc ? row1 - (bltsizeV - 1) * stride : row1 + (bltsizeV - 1) * stride;
+
+    // Compute the address range covered by the channel
+    i64 lo = std::min(row1, row2) - (desc ? 2 * (bltsizeH - 1) : 0);
+    i64 hi = std::max(row1, row2) + (desc ? 0 : 2 * (bltsizeH - 1)) + 1;
+
+    // The range must not wrap around
+    if (lo < 0 || hi > i64(agnus.ptrMask)) return nullptr;
+
+    // The range must be directly accessible as a whole
+    isize bytes = isize(hi - lo + 1);
+    u8 *p = mem.rawChipPtr(u32(lo), bytes);
+    if (!p || bytes != hi - lo + 1) return nullptr;
+
+    first = u32(lo);
+    last = u32(hi);
+    return p + (pt - lo);
+}
+
 void
 Blitter::doFastLineBlit()
 {
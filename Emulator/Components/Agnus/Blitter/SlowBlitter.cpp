@@ -1188,7 +1188,7 @@ Blitter::exec()
         trace(BLT_DEBUG, "HOLD_D\n");
 
         // Run the minterm logic circuit
-        dhold = doMintermLogic(ahold, bhold, chold, bltcon0 & 0xFF);
+        dhold = doMintermLogicQuick(ahold, bhold, chold, bltcon0 & 0xFF);
 
         if (BLT_DEBUG) {
             assert(dhold == doMintermLogic(ahold, bhold, chold, bltcon0 & 0xFF));
@@ -14,6 +14,7 @@
 #include "Checksum.h"
 #include "IOUtils.h"
 #include "PixelEngine.h"
+#include <bit>
 
 namespace vamiga {
 
@@ -25,6 +26,45 @@ Copper::Copper(Amiga& ref) : SubComponent(ref)
     };
 }
 
+void
+Copper::_didReset(bool hard)
+{
+    discardProgram();
+}
+
+void
+Copper::_didLoad()
+{
+    discardProgram();
+}
+
+i64
+Copper::getOption(Option option) const
+{
+    switch (option) {
+
+        case OPT_COPPER_REPLAY: return config.replay;
+
+        default:
+            fatalError;
+    }
+}
+
+void
+Copper::setOption(Option option, i64 value)
+{
+    switch (option) {
+
+        case OPT_COPPER_REPLAY:
+
+            config.replay = bool(value);
+            return;
+
+        default:
+            fatalError;
+    }
+}
+
 void
 Copper::setPC(u32 addr)
 {
@@ -97,7 +137,7 @@ Copper::findMatchOld(Beam &match) const
 }
 
 bool
-Copper::findMatch(Beam &match) const
+Copper::findMatch(Beam &match)
 {
     // Start searching at the current beam position
     u32 beam = (u32)(agnus.pos.v << 8 | agnus.pos.h);
@@ -106,37 +146,62 @@ Copper::findMatch(Beam &match) const
     u32 comp = getVPHP();
     u32 mask = getVMHM();
 
-    // Iterate through all lines starting from the current position
+    // Get the number of lines in the current frame
     isize numLines = agnus.pos.vCnt();
+
+    // Look up the trigger position in the cache
+    u64 key = u64(comp) << 48 | u64(mask) << 32 | u64(numLines) << 17 | beam;
+    auto &entry = waitCache[(key * 0x9E3779B97F4A7C15) >> 58];
+
+    if (entry.key != key) {
+
+        entry.key = key;
+        entry.trigger = computeMatch(beam, comp, mask, numLines);
+    }
+
+    // Compare the result with the reference implementation if requested
+    if (COP_ON_STEROIDS) {
+
+        i32 trigger = scanMatch(beam, comp, mask, numLines);
+
+        if (trigger != entry.trigger) {
+
+            fatal("Copper WAIT mismatch: beam = %X VPHP = %X VMHM = %X (%X != %X)\n",
+                  beam, comp, mask, entry.trigger, trigger);
+        }
+    }
+
+    if (entry.trigger < 0) return false;
+
+    match.v = entry.trigger >> 8;
+    match.h = entry.trigger & 0xFF;
+    return true;
+}
+
+i32
+Copper::scanMatch(u32 beam, u32 comp, u32 mask, isize numLines) const
+{
+    // Iterate through all lines starting from the given position
     while ((isize)(beam >> 8) < numLines) {
 
         // Check if the vertical components are equal
         if ((beam & mask & ~0xFF) == (comp & mask & ~0xFF)) {
 
             // Try to match the horizontal coordinate as well
-            if (findHorizontalMatch(beam, comp, mask)) {
-
-                // Success
-                match.v = beam >> 8;
-                match.h = beam & 0xFF;
-                return true;
-            }
+            if (findHorizontalMatch(beam, comp, mask)) return i32(beam);
         }
 
         // Check if the vertical beam position is greater
         else if ((beam & mask & ~0xFF) > (comp & mask & ~0xFF)) {
 
-            // Success
-            match.v = beam >> 8;
-            match.h = beam & 0xFF;
-            return true;
+            return i32(beam);
         }
 
         // Jump to the beginning of the next line
         beam = (beam & ~0xFF) + 0x100;
     }
 
-    return false;
+    return -1;
 }
 
 bool
@@ -191,6 +256,106 @@ Copper::findHorizontalMatch(u32 &match, u32 comp, u32 mask) const
     return false;
 }
 
+// Returns the smallest submask of 'mask' that is greater than or equal to 'comp'
+static u32
+nextSubmask(u32 comp, u32 mask)
+{
+    // Check if 'comp' is a submask already
+    u32 bad = comp & ~mask;
+    if (!bad) return comp;
+
+    // Set the lowest free mask bit above the highest bit outside the mask
+    u32 above = mask & ~comp & ~((2u << (std::bit_width(bad) - 1)) - 1);
+    assert(above);
+    u32 bit = u32(std::countr_zero(above));
+
+    return (comp & ~((2u << bit) - 1)) | (1u << bit);
+}
+
+// Returns the smallest value y >= x with (y & mask) >= comp
+static u32
+nextMatch(u32 x, u32 comp, u32 mask)
+{
+    if ((x & mask) >= comp) return x;
+
+    /* A value y > x is composed of the bits of x above some position k where
+     * x has a 0 bit, a 1 bit at position k, and an arbitrary lower part.
+     * Hence, the first position k (starting from the LSB) that can satisfy
+     * the comparison yields the smallest y.
+     */
+    for (u32 k = 0; k < 16; k++) {
+
+        if (x & (1u << k)) continue;
+
+        u32 low = (1u << k) - 1;
+        u32 y = (x & ~low) | (1u << k);
+
+        // Check if the upper part satisfies the comparison on its own
+        if ((y & mask) >= comp) return y;
+
+        // Check if the lower part can make up for the difference
+        if (((y | low) & mask) < comp) continue;
+
+        // The upper parts coincide. Complete the lower part minimally
+        return y | nextSubmask(comp & low, mask & low);
+    }
+
+    return UINT32_MAX;
+}
+
+i32
+Copper::computeMatch(u32 beam, u32 comp, u32 mask, isize numLines) const
+{
+    u32 v = beam >> 8;
+    u32 h = beam & 0xFF;
+    u32 vmask = HI_BYTE(mask);
+    u32 vcomp = HI_BYTE(comp) & vmask;
+
+    if (isize(v) >= numLines) return -1;
+
+    // Check the current line
+    if ((v & vmask) == vcomp) {
+
+        if (auto hmatch = computeHorizontalMatch(h, comp, mask); hmatch >= 0) {
+            return i32(v << 8 | hmatch);
+        }
+
+    } else if ((v & vmask) > vcomp) {
+
+        return i32(beam);
+    }
+
+    /* Check the upcoming lines. In each of these lines, the search starts at
+     * the beginning of the line. Hence, the horizontal trigger position is
+     * the same in all lines. If it doesn't exist, the vertical position has
+     * to be greater than the comparison value.
+     */
+    auto hmatch = computeHorizontalMatch(0, comp, mask);
+    auto line = nextMatch(v + 1, hmatch >= 0 ? vcomp : vcomp + 1, vmask);
+
+    if (isize(line) >= numLines) return -1;
+    return i32(line << 8 | ((line & vmask) == vcomp ? hmatch : 0));
+}
+
+i32
+Copper::computeHorizontalMatch(u32 h, u32 comp, u32 mask) const
+{
+    u32 hmask = LO_BYTE(mask);
+    u32 hcomp = LO_BYTE(comp) & hmask;
+
+    // Check all horizontal positions except the last three
+    if (h + 2 <= 0xE1) {
+
+        if (auto i = nextMatch(h + 2, hcomp, hmask); i <= 0xE1) return i32(i - 2);
+        h = 0xE0;
+    }
+
+    // Check the last three cycles with a wrapped over counter
+    if (auto i = nextMatch(0, hcomp, hmask); i <= 2) return i32(h + i);
+
+    return -1;
+}
+
 void
 Copper::move(u32 addr, u16 value)
 {
@@ -31,10 +31,15 @@ class Copper : public SubComponent, public Inspectable<CopperInfo>
 
     ConfigOptions options = {
 
+        OPT_COPPER_REPLAY
     };
 
+    // Current configuration
+    CopperConfig config = {};
+
     friend class Agnus;
     friend class CopperDebugger;
+    friend class RegressionTester;
     
 public:
 
@@ -75,13 +80,81 @@ private:
      */
     bool activeInThisFrame = false;
 
+    /* Cache with recently computed WAIT trigger positions. Static Copper
+     * lists execute the same WAIT commands at the same beam positions in
+     * each frame. The cache resolves these commands without recomputing the
+     * trigger position. Each entry is keyed by the comparison position, the
+     * comparison mask, the start position, and the number of lines in the
+     * current frame. It stores the trigger position in (v << 8 | h) format
+     * or -1 if the Copper does not wake up in the current frame.
+     */
+    struct WaitCacheEntry { u64 key = 0; i32 trigger = -1; };
+    WaitCacheEntry waitCache[64];
+
+
+    //
+    // Replaying Copper lists
+    //
+
+    /* In replay mode, the Copper records the MOVEs it executes in a frame
+     * together with the beam positions of the corresponding register writes.
+     * If the next frame starts under the same conditions and the Copper list
+     * memory hasn't been touched, the recorded MOVEs are replayed with a
+     * single event per MOVE. In this case, the Copper doesn't fetch or
+     * decode any instructions and skips the event chain of WAIT commands.
+     */
+    struct ReplayStep {
+
+        i32 beam;       // Beam position of the register write (v << 8 | h)
+        u32 pc;         // Program counter after the MOVE
+        u16 ins1;       // First instruction word
+        u16 ins2;       // Second instruction word
+        i16 list;       // Active Copper list
+    };
+
+    // Conditions under which a program has been recorded
+    struct ReplayKey {
+
+        u32 cop1lc;
+        u32 cop2lc;
+        u16 dmacon;
+        u16 bplcon0;
+        u16 ddfstrt;
+        u16 ddfstop;
+        bool cdang;
+
+        bool operator==(const ReplayKey &) const = default;
+    };
+
+    // The recorded program
+    std::vector<ReplayStep> program;
+    ReplayKey programKey = { };
+
+    // Chip Ram pages the program has been fetched from
+    std::vector<isize> programPages;
+
+    // Memory checkpoint taken when the recording started
+    u32 programStamp = 0;
+
+    // Indicates if the recorded program can be replayed
+    bool programValid = false;
+
+    // Indicates if the Copper is recording the current frame
+    bool recording = false;
+
+    // Index of the next MOVE to replay (-1 if no replay is in progress)
+    isize replayStep = -1;
+
 public:
 
     // Indicates if breakpoint or watchpoint checking is needed
     bool checkForBreakpoints = false;
     bool checkForWatchpoints = false;
 
-    // Indicates if Copper is currently servicing an event (for debugging only)
+    /* Indicates if the Copper is currently servicing an event. The flag tells
+     * Copper writes to COP1LC and COP2LC apart from CPU writes, which cancel
+     * recording and replaying. It is also evaluated by the debugger.
+     */
     bool servicing = false;
     
 
@@ -116,6 +189,9 @@ public:
         CLONE(coppc0)
         CLONE(activeInThisFrame)
 
+        // Recorded programs are bound to the memory stamps of this instance
+        discardProgram();
+
         return *this;
     }
 
@@ -160,6 +236,19 @@ public:
 private:
 
     void _dump(Category category, std::ostream& os) const override;
+    void _didReset(bool hard) override;
+    void _didLoad() override;
+
+
+    //
+    // Methods from Configurable
+    //
+
+public:
+
+    const CopperConfig &getConfig() const { return config; }
+    i64 getOption(Option option) const override;
+    void setOption(Option option, i64 value) override;
 
 
     //
@@ -217,12 +306,25 @@ private:
      *        Variable 'result' remains untouched.
      */
     bool findMatchOld(Beam &result) const; // DEPRECATED
-    bool findMatch(Beam &result) const;
+    bool findMatch(Beam &result);
+
+    /* Reference implementation of computeMatch() scanning line by line. It
+     * is used to cross-check the closed-form search in debug builds and by
+     * the regression tester.
+     */
+    i32 scanMatch(u32 beam, u32 comp, u32 mask, isize numLines) const;
 
-    // Called by findMatch() to determine the horizontal trigger position
+    // Called by scanMatch() to determine the horizontal trigger position
     bool findHorizontalMatchOld(u32 &beam, u32 comp, u32 mask) const; // DEPRECATED
     bool findHorizontalMatch(u32 &beam, u32 comp, u32 mask) const;
 
+    /* Computes the trigger position of a WAIT command in closed form. The
+     * function is called by findMatch() on a cache miss and returns the
+     * trigger position in (v << 8 | h) format or -1 if there is none.
+     */
+    i32 computeMatch(u32 beam, u32 comp, u32 mask, isize numLines) const;
+    i32 computeHorizontalMatch(u32 h, u32 comp, u32 mask) const;
+
     // Emulates the Copper writing a value into one of the custom registers
     void move(u32 addr, u16 value);
 
@@ -243,6 +345,41 @@ private:
     void scheduleWaitWakeup(bool bfd);
 
 
+    //
+    // Replaying Copper lists (CopperReplay.cpp)
+    //
+
+private:
+
+    // Starts a replay or a new recording (called at the beginning of a frame)
+    bool beginReplay();
+
+    // Returns the conditions the current frame starts under
+    ReplayKey replayKey() const;
+
+    // Checks if the Copper list memory has been modified since recording
+    bool programModified() const;
+
+    // Records an instruction fetch or an executed MOVE
+    void recordFetch(u32 addr);
+    void recordMove();
+
+    // Stops recording without producing a valid program
+    void abortRecording();
+
+    // Replays the next MOVE (called by the COP_REPLAY event handler)
+    void replayMove();
+
+    // Schedules the next COP_REPLAY event
+    void scheduleReplay();
+
+    // Cancels a replay and continues with exact emulation
+    void cancelReplay();
+
+    // Deletes the recorded program
+    void discardProgram();
+
+
     //
     // Analyzing Copper instructions
     //
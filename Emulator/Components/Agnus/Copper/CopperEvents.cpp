@@ -62,6 +62,7 @@ Copper::serviceEvent(EventID id)
 
                 // Reschedule the wakeup event
                 xfiles("Copper wakeup aborted\n");
+                if (recording) abortRecording();
                 scheduleWaitWakeup(getBFD());
             }
             break;
@@ -112,6 +113,7 @@ Copper::serviceEvent(EventID id)
             
             // Load the first instruction word
             cop1ins = agnus.doCopperDmaRead(coppc);
+            if (recording) recordFetch(coppc);
             advancePC();
 
             if (COP_CHECKSUM) {
@@ -132,6 +134,7 @@ Copper::serviceEvent(EventID id)
 
             // Load the second instruction word
             cop2ins = agnus.doCopperDmaRead(coppc);
+            if (recording) recordFetch(coppc);
             advancePC();
 
             if (COP_CHECKSUM) checksum = util::fnvIt32(checksum, cop2ins);
@@ -160,6 +163,7 @@ Copper::serviceEvent(EventID id)
                     break;
                 default:
                     move(reg, cop2ins);
+                    if (recording) recordMove();
             }
             
             // Check if a watchpoint has been reached
@@ -178,6 +182,7 @@ Copper::serviceEvent(EventID id)
 
             // Load the second instruction word
             cop2ins = agnus.doCopperDmaRead(coppc);
+            if (recording) recordFetch(coppc);
             advancePC();
 
             if (COP_CHECKSUM) checksum = util::fnvIt32(checksum, cop2ins);
@@ -203,7 +208,10 @@ Copper::serviceEvent(EventID id)
 
             // Clear the skip flag
             skip = false;
-            
+
+            // Waits depending on the Blitter can't be replayed
+            if (!getBFD() && recording) abortRecording();
+
             // Check if we need to wait for the Blitter
             if (!getBFD() && agnus.blitter.isActive()) {
                 agnus.scheduleAbs<SLOT_COP>(NEVER, COP_WAIT_BLIT);
@@ -236,6 +244,9 @@ Copper::serviceEvent(EventID id)
 
             trace(COP_DEBUG, "COP_SKIP1\n");
 
+            // Skip commands can't be replayed
+            if (recording) abortRecording();
+
             // Wait for the next possible DMA cycle
             if (!agnus.busIsFree<BUS_COPPER>()) { reschedule(); break; }
 
@@ -284,9 +295,20 @@ Copper::serviceEvent(EventID id)
 
             switchToCopperList(1);
             activeInThisFrame = agnus.copdma();
+
+            // Replay the recorded program if possible
+            if (beginReplay()) break;
+
             schedule(COP_FETCH);
             break;
 
+        case COP_REPLAY:
+
+            trace(COP_DEBUG, "COP_REPLAY\n");
+
+            replayMove();
+            break;
+
         default:
             fatalError;
     }
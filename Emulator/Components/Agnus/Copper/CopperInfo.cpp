@@ -18,6 +18,11 @@ Copper::_dump(Category category, std::ostream& os) const
 {
     using namespace util;
 
+    if (category == Category::Config) {
+
+        dumpConfig(os);
+    }
+
     if (category == Category::List1 || category == Category::List2) {
 
         debugger.dump(category, os);
@@ -47,6 +52,10 @@ Copper::_dump(Category category, std::ostream& os) const
         os << dec(copList) << std::endl;
         os << tab("Skip flag");
         os << bol(skip) << std::endl;
+        os << tab("Recorded MOVEs");
+        os << dec(program.size()) << (programValid ? "" : " (invalid)") << std::endl;
+        os << tab("Replaying");
+        os << bol(replayStep >= 0) << std::endl;
     }
 }
 
@@ -40,6 +40,8 @@ Copper::pokeCOPJMP1()
         if (agnus.blitter.isActive()) {
             xfiles("pokeCOPJMP1: Blitter is running\n");
         }
+        if (recording) abortRecording();
+        if (replayStep >= 0) cancelReplay();
         switchToCopperList(1);
     }
 }
@@ -59,6 +61,8 @@ Copper::pokeCOPJMP2()
         if (agnus.blitter.isActive()) {
             xfiles("pokeCOPJMP2: Blitter is running\n");
         }
+        if (recording) abortRecording();
+        if (replayStep >= 0) cancelReplay();
         switchToCopperList(2);
     }
 }
@@ -92,6 +96,13 @@ Copper::pokeCOP1LCH(u16 value)
         
         cop1lc = REPLACE_HI_WORD(cop1lc, value);
 
+        // Changes made by the CPU interfere with recording and replaying
+        if (!servicing) {
+
+            if (recording) abortRecording();
+            if (replayStep >= 0) cancelReplay();
+        }
+
         if (!activeInThisFrame && copList == 1) {
             setPC(cop1lc);
         }
@@ -108,6 +119,13 @@ Copper::pokeCOP1LCL(u16 value)
     if (LO_WORD(cop1lc) != value) {
         
         cop1lc = REPLACE_LO_WORD(cop1lc, value);
+
+        // Changes made by the CPU interfere with recording and replaying
+        if (!servicing) {
+
+            if (recording) abortRecording();
+            if (replayStep >= 0) cancelReplay();
+        }
         
         if (!activeInThisFrame && copList == 1) {
             setPC(cop1lc);
@@ -124,6 +142,13 @@ Copper::pokeCOP2LCH(u16 value)
         
         cop2lc = REPLACE_HI_WORD(cop2lc, value);
 
+        // Changes made by the CPU interfere with recording and replaying
+        if (!servicing) {
+
+            if (recording) abortRecording();
+            if (replayStep >= 0) cancelReplay();
+        }
+
         if (!activeInThisFrame && copList == 2) {
             setPC(cop2lc);
         }
@@ -140,6 +165,13 @@ Copper::pokeCOP2LCL(u16 value)
     if (LO_WORD(cop2lc) != value) {
 
         cop2lc = REPLACE_LO_WORD(cop2lc, value);
+
+        // Changes made by the CPU interfere with recording and replaying
+        if (!servicing) {
+
+            if (recording) abortRecording();
+            if (replayStep >= 0) cancelReplay();
+        }
         
         if (!activeInThisFrame && copList == 2) {
             setPC(cop2lc);
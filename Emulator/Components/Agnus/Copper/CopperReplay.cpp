@@ -0,0 +1,235 @@
+// -----------------------------------------------------------------------------
+// This file is part of vAmiga
+//
+// Copyright (C) Dirk W. Hoffmann. www.dirkwhoffmann.de
+// Licensed under the Mozilla Public License v2
+//
+// See https://mozilla.org/MPL/2.0 for license information
+// -----------------------------------------------------------------------------
+
+#include "config.h"
+#include "Copper.h"
+#include "Emulator.h"
+
+namespace vamiga {
+
+bool
+Copper::beginReplay()
+{
+    /* This function is called at the beginning of each frame. If the Copper
+     * has recorded the previous frame without interruption, the recorded
+     * program becomes available for replay. The program is replayed as long
+     * as each frame starts under the same conditions and the Copper list
+     * memory remains untouched. Otherwise, a new recording is started.
+     */
+
+    if (recording) {
+
+        recording = false;
+        programValid = !program.empty();
+    }
+
+    replayStep = -1;
+
+    // Replaying is disabled while the Copper is debugged
+    bool debugging =
+    checkForBreakpoints || checkForWatchpoints || emulator.isTracking() || COP_CHECKSUM;
+
+    if (!config.replay || debugging || !activeInThisFrame) {
+
+        programValid = false;
+        return false;
+    }
+
+    auto key = replayKey();
+
+    if (programValid && key == programKey && !programModified()) {
+
+        trace(COP_DEBUG, "Replaying %zu MOVEs\n", program.size());
+
+        replayStep = 0;
+        scheduleReplay();
+        return true;
+    }
+
+    // Record the current frame
+    program.clear();
+    programPages.clear();
+    programKey = key;
+    programStamp = mem.checkpoint();
+    programValid = false;
+    recording = true;
+
+    return false;
+}
+
+Copper::ReplayKey
+Copper::replayKey() const
+{
+    return ReplayKey {
+
+        .cop1lc  = cop1lc,
+        .cop2lc  = cop2lc,
+        .dmacon  = agnus.dmacon,
+        .bplcon0 = agnus.bplcon0,
+        .ddfstrt = agnus.sequencer.ddfstrt,
+        .ddfstop = agnus.sequencer.ddfstop,
+        .cdang   = cdang
+    };
+}
+
+bool
+Copper::programModified() const
+{
+    for (auto page : programPages) {
+        if (mem.isModified(MEM_CHIP, page, programStamp)) return true;
+    }
+    return false;
+}
+
+void
+Copper::recordFetch(u32 addr)
+{
+    assert(recording);
+
+    addr &= agnus.ptrMask;
+
+    // Only programs located in Chip Ram are recorded
+    if (mem.agnusMemSrc[addr >> 16] != MEM_CHIP) { abortRecording(); return; }
+
+    isize page = isize((addr & mem.chipMask) >> MEM_PAGE_SHIFT);
+
+    if (programPages.empty() || programPages.back() != page) {
+
+        if (std::find(programPages.begin(), programPages.end(), page) == programPages.end()) {
+            programPages.push_back(page);
+        }
+    }
+}
+
+void
+Copper::recordMove()
+{
+    assert(recording);
+
+    program.push_back(ReplayStep {
+
+        .beam = i32(agnus.pos.v << 8 | agnus.pos.h),
+        .pc   = coppc,
+        .ins1 = cop1ins,
+        .ins2 = cop2ins,
+        .list = i16(copList)
+    });
+}
+
+void
+Copper::abortRecording()
+{
+    if (recording) trace(COP_DEBUG, "Recording aborted\n");
+
+    recording = false;
+    programValid = false;
+}
+
+void
+Copper::discardProgram()
+{
+    program.clear();
+    programPages.clear();
+    programValid = false;
+    recording = false;
+    replayStep = -1;
+}
+
+void
+Copper::replayMove()
+{
+    // Fall back to exact emulation if the program is no longer usable
+    if (!config.replay || !programValid || replayStep < 0 || replayStep >= isize(program.size())) {
+
+        cancelReplay();
+        return;
+    }
+
+    // Fall back to exact emulation if the Copper list has been modified
+    if (programModified()) {
+
+        trace(COP_DEBUG, "Copper list modified\n");
+        cancelReplay();
+        return;
+    }
+
+    // Fall back to exact emulation if the Copper can't write in this cycle
+    if (!agnus.busIsFree<BUS_COPPER>()) {
+
+        trace(COP_DEBUG, "Bus is blocked\n");
+        cancelReplay();
+        return;
+    }
+
+    auto &step = program[replayStep];
+
+    // Fall back to exact emulation if the register has become inaccessible
+    if (isIllegalAddress(step.ins1 & 0x1FE)) {
+
+        trace(COP_DEBUG, "Illegal register\n");
+        cancelReplay();
+        return;
+    }
+
+    replayStep++;
+
+    // Restore the state of the exact Copper after this MOVE
+    copList = step.list;
+    cop1ins = step.ins1;
+    cop2ins = step.ins2;
+    coppc0 = step.pc - 4;
+    coppc = step.pc;
+
+    // Write value into custom register
+    move(step.ins1 & 0x1FE, step.ins2);
+
+    if (replayStep < isize(program.size())) {
+
+        scheduleReplay();
+
+    } else {
+
+        // Continue with the instructions following the last MOVE
+        replayStep = -1;
+        schedule(COP_FETCH);
+    }
+}
+
+void
+Copper::scheduleReplay()
+{
+    assert(replayStep >= 0 && replayStep < isize(program.size()));
+
+    auto &step = program[replayStep];
+    auto v = isize(step.beam >> 8);
+    auto h = isize(step.beam & 0xFF);
+
+    // The recorded positions must lie ahead of the current position
+    if (v < agnus.pos.v || (v == agnus.pos.v && h <= agnus.pos.h)) {
+
+        cancelReplay();
+        return;
+    }
+
+    agnus.scheduleRel <SLOT_COP> (DMA_CYCLES(agnus.pos.diff(v, h)), COP_REPLAY);
+}
+
+void
+Copper::cancelReplay()
+{
+    trace(COP_DEBUG, "Replay canceled at step %ld\n", replayStep);
+
+    replayStep = -1;
+    programValid = false;
+
+    // Continue with the instruction the program counter points to
+    agnus.scheduleRel <SLOT_COP> (DMA_CYCLES(0), COP_REQ_DMA);
+}
+
+}
@@ -15,6 +15,12 @@
 // Structures
 //
 
+typedef struct
+{
+    bool replay;
+}
+CopperConfig;
+
 typedef struct
 {
     isize copList;
@@ -10,6 +10,7 @@
 #include "config.h"
 #include "Sequencer.h"
 #include "Agnus.h"
+#include <mutex>
 
 namespace vamiga {
 
@@ -21,7 +22,9 @@ Sequencer::Sequencer(Amiga& ref) : SubComponent(ref)
 void
 Sequencer::_initialize()
 {
-    initDasEventTable();
+    // The DAS event table is shared by all emulator instances
+    static std::once_flag flag;
+    std::call_once(flag, initDasEventTable);
 }
 
 void
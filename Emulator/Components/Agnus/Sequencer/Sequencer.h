@@ -250,7 +250,7 @@ public:
 
 private:
     
-    void initDasEventTable();
+    static void initDasEventTable();
 
 
     //
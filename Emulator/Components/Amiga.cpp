@@ -175,6 +175,8 @@ Amiga::getOption(Option option) const
         case OPT_AMIGA_SNAPSHOTS:       return config.snapshots;
         case OPT_AMIGA_SNAPSHOT_DELAY:  return config.snapshotDelay;
         case OPT_AMIGA_RUN_AHEAD:       return config.runAhead;
+        case OPT_AMIGA_REWIND:          return config.rewind;
+        case OPT_AMIGA_REWIND_BUDGET:   return config.rewindBudget;
 
         default:
             fatalError;
@@ -233,6 +235,20 @@ Amiga::checkOption(Option opt, i64 value)
             }
             return;
 
+        case OPT_AMIGA_REWIND:
+
+            if (value < 0 || value > 600) {
+                throw Error(ERROR_OPT_INV_ARG, "0...600");
+            }
+            return;
+
+        case OPT_AMIGA_REWIND_BUDGET:
+
+            if (value < 1 || value > 1024) {
+                throw Error(ERROR_OPT_INV_ARG, "1...1024");
+            }
+            return;
+
         default:
             throw Error(ERROR_OPT_UNSUPPORTED);
     }
@@ -289,6 +305,16 @@ Amiga::setOption(Option option, i64 value)
             config.runAhead = isize(value);
             return;
 
+        case OPT_AMIGA_REWIND:
+
+            config.rewind = isize(value);
+            return;
+
+        case OPT_AMIGA_REWIND_BUDGET:
+
+            config.rewindBudget = isize(value);
+            return;
+
         default:
             fatalError;
     }
@@ -1008,6 +1034,31 @@ Amiga::takeSnapshot()
     }
 }
 
+void
+Amiga::saveSnapshot(std::ostream &stream)
+{
+    {   SUSPENDED
+
+        Snapshot::compress(*this, stream);
+    }
+}
+
+void
+Amiga::saveSnapshot(const std::filesystem::path &path)
+{
+    if (util::isDirectory(path)) {
+        throw Error(ERROR_FILE_IS_DIRECTORY);
+    }
+
+    std::ofstream stream(path, std::ofstream::binary);
+
+    if (!stream.is_open()) {
+        throw Error(ERROR_FILE_CANT_WRITE, path);
+    }
+
+    saveSnapshot(stream);
+}
+
 void
 Amiga::serviceSnpEvent(EventID eventId)
 {
@@ -1214,16 +1265,21 @@ Amiga::setAlarmRel(Cycle trigger, i64 payload)
 void
 Amiga::serviceAlarmEvent()
 {
+    std::vector<i64> payloads;
+
+    // Remove all pending alarms (the client may set new alarms when notified)
     for (auto it = alarms.begin(); it != alarms.end(); ) {
 
         if (it->trigger <= agnus.clock) {
-            msgQueue.put(MSG_ALARM, it->payload);
+            payloads.push_back(it->payload);
             it = alarms.erase(it);
         } else {
             it++;
         }
     }
     scheduleNextAlarm();
+
+    for (auto payload : payloads) msgQueue.put(MSG_ALARM, payload);
 }
 
 void
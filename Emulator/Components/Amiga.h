@@ -74,7 +74,9 @@ class Amiga final : public CoreComponent, public Inspectable<AmigaInfo> {
         OPT_AMIGA_SPEED_BOOST,
         OPT_AMIGA_SNAPSHOTS,
         OPT_AMIGA_SNAPSHOT_DELAY,
-        OPT_AMIGA_RUN_AHEAD
+        OPT_AMIGA_RUN_AHEAD,
+        OPT_AMIGA_REWIND,
+        OPT_AMIGA_REWIND_BUDGET
     };
     
     // The current configuration
@@ -440,6 +442,10 @@ public:
     // Takes a snapshot
     MediaFile *takeSnapshot();
 
+    // Writes a compressed snapshot into a stream or file
+    void saveSnapshot(std::ostream &stream) throws;
+    void saveSnapshot(const std::filesystem::path &path) throws;
+
     // Loads the current state from a snapshot file
     void loadSnapshot(const MediaFile &file) throws;
     void loadSnapshot(const class Snapshot &snapshot) throws;
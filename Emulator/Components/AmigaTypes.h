@@ -324,6 +324,12 @@ typedef struct
 
     //! Number of run-ahead frames (0 = run-ahead is disabled)
     isize runAhead;
+
+    //! Length of the rewind buffer in seconds (0 = rewinding is disabled)
+    isize rewind;
+
+    //! Memory budget of the rewind buffer in MB
+    isize rewindBudget;
 }
 AmigaConfig;
 
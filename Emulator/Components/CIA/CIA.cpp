@@ -736,6 +736,38 @@ CIA::wakeUp()
 
 void
 CIA::wakeUp(Cycle targetCycle)
+{
+    // Make up for missed cycles
+    catchUp(targetCycle);
+    
+    // Schedule the next execution event
+    scheduleNextExecution();
+}
+
+void
+CIA::catchUp()
+{
+    if (!sleeping) return;
+
+    Cycle targetCycle = CIA_CYCLES(AS_CIA_CYCLES(agnus.clock));
+
+    // Wake up if the wakeup cycle has already been reached
+    if (targetCycle >= wakeUpCycle) {
+        
+        wakeUp();
+        return;
+    }
+
+    /* While sleeping, the delay pipeline is in a stable state and the timers
+     * are too far away from an underflow to trigger anything. Hence, the CIA
+     * would do nothing but count down the timers if we woke it up. We can
+     * therefore bring the timers up to date and continue to sleep.
+     */
+    catchUp(targetCycle);
+}
+
+void
+CIA::catchUp(Cycle targetCycle)
 {
     assert(clock == sleepCycle);
 
@@ -743,7 +775,6 @@ CIA::wakeUp(Cycle targetCycle)
     Cycle missedCycles = targetCycle - sleepCycle;
     assert(missedCycles % CIA_CYCLES(1) == 0);
     
-    // Make up for missed cycles
     if (missedCycles > 0) {
         
         if (feed & CIACountA0) {
@@ -759,10 +790,8 @@ CIA::wakeUp(Cycle targetCycle)
         
         idleCycles += missedCycles;
         clock = targetCycle;
+        sleepCycle = targetCycle;
     }
-    
-    // Schedule the next execution event
-    scheduleNextExecution();
 }
 
 CIACycle
@@ -297,7 +297,7 @@ public:
     bool sleeping;
     
     /* The last executed cycle before the chip went idle.
-     * The variable is set in sleep()
+     * The variable is set in sleep() and advanced in catchUp()
      */
     Cycle sleepCycle;
     
@@ -637,6 +637,19 @@ public:
     // Emulates all previously skipped cycles
     void wakeUp();
     void wakeUp(Cycle targetCycle);
+
+    /* Emulates all previously skipped cycles without waking up the CIA. This
+     * function is called on register reads that have no side effects. It
+     * brings the timers up to date and lets the CIA continue to sleep.
+     */
+    void catchUp();
+
+private:
+
+    // Advances the clock and the timers of a sleeping CIA
+    void catchUp(Cycle targetCycle);
+
+public:
     
     // Returns true if the CIA is in idle state or not
     bool isSleeping() const { return sleeping; }
@@ -21,7 +21,8 @@ CIA::peek(u16 addr)
 
     u8 result;
 
-    wakeUp();
+    // Only reading the ICR has side effects on the internal state
+    if (addr == 0x0D) wakeUp(); else catchUp();
 
     switch(addr) {
             
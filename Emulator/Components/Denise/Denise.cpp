@@ -16,6 +16,36 @@
 
 namespace vamiga {
 
+// Returns the shift amount that moves a byte to the i-th memory position
+static constexpr isize byteShift(isize i)
+{
+    return 8 * (std::endian::native == std::endian::little ? i : 7 - i);
+}
+
+// Planar-to-chunky lookup table for hires pixels (8 bits to 8 bytes)
+static constexpr auto c2pHires = []() {
+
+    std::array<u64, 256> table {};
+    for (isize b = 0; b < 256; b++) {
+        for (isize i = 0; i < 8; i++) {
+            if (b & (0x80 >> i)) table[b] |= u64(1) << byteShift(i);
+        }
+    }
+    return table;
+}();
+
+// Planar-to-chunky lookup table for lores pixels (4 bits to 8 bytes)
+static constexpr auto c2pLores = []() {
+
+    std::array<u64, 16> table {};
+    for (isize b = 0; b < 16; b++) {
+        for (isize i = 0; i < 8; i++) {
+            if (b & (0x8 >> (i / 2))) table[b] |= u64(1) << byteShift(i);
+        }
+    }
+    return table;
+}();
+
 Denise::Denise(Amiga& ref) : SubComponent(ref)
 {    
     subComponents = std::vector<CoreComponent *> {
@@ -192,42 +222,78 @@ Denise::updateShiftRegistersEven()
     }
 }
 
-void
-Denise::extractSlices(u8 slices[16])
+template <Resolution mode, u8 planes> void
+Denise::extractSlices(u64 slices[4])
 {
-    u16 mask = 0x8000;
-    for (isize i = 0; i < 16; i++, mask >>= 1) {
-        
-        slices[i] = (u8) ((!!(shiftReg[0] & mask) << 0) |
-                          (!!(shiftReg[1] & mask) << 1) |
-                          (!!(shiftReg[2] & mask) << 2) |
-                          (!!(shiftReg[3] & mask) << 3) |
-                          (!!(shiftReg[4] & mask) << 4) |
-                          (!!(shiftReg[5] & mask) << 5) );
-    }
-}
+    /* This function performs the planar-to-chunky conversion for the shift
+     * registers selected by 'planes'. The results are stored as packed
+     * bytes, one byte per pixel. In lores mode, each pixel is stored twice.
+     */
+    slices[0] = slices[1] = slices[2] = slices[3] = 0;
 
-void
-Denise::extractSlicesOdd(u8 slices[16])
-{
-    u16 mask = 0x8000;
-    for (isize i = 0; i < 16; i++, mask >>= 1) {
-        
-        slices[i] = (u8) ((!!(shiftReg[0] & mask) << 0) |
-                          (!!(shiftReg[2] & mask) << 2) |
-                          (!!(shiftReg[4] & mask) << 4) );
+    for (isize n = 0; n < 6; n++) {
+
+        if (!(planes & (1 << n))) continue;
+
+        u16 reg = shiftReg[n];
+
+        if constexpr (mode == LORES) {
+
+            slices[0] |= c2pLores[(reg >> 12)      ] << n;
+            slices[1] |= c2pLores[(reg >>  8) & 0xF] << n;
+            slices[2] |= c2pLores[(reg >>  4) & 0xF] << n;
+            slices[3] |= c2pLores[(reg >>  0) & 0xF] << n;
+
+        } else {
+
+            slices[0] |= c2pHires[(reg >> 8)       ] << n;
+            slices[1] |= c2pHires[(reg >> 0) & 0xFF] << n;
+        }
     }
 }
 
-void
-Denise::extractSlicesEven(u8 slices[16])
+template <Resolution mode, u8 planes> void
+Denise::mergeSlices(Pixel pixel, const u64 slices[4], u8 mask)
 {
-    u16 mask = 0x8000;
-    for (isize i = 0; i < 16; i++, mask >>= 1) {
-        
-        slices[i] = (u8) ((!!(shiftReg[1] & mask) << 1) |
-                          (!!(shiftReg[3] & mask) << 3) |
-                          (!!(shiftReg[5] & mask) << 5) );
+    if constexpr (mode == SHRES) {
+
+        // Bits to preserve when writing the first and second half of a pixel
+        constexpr u8 keep1 =
+        planes == 0b010101 ? 0b111011 : planes == 0b101010 ? 0b110111 : 0;
+        constexpr u8 keep2 =
+        planes == 0b010101 ? 0b111110 : planes == 0b101010 ? 0b111101 : 0xFF;
+
+        assert(pixel + 8 <= isizeof(dBuffer));
+
+        // Synthesize 8 superHires pixels out of 16 slices
+        u8 s[16];
+        std::memcpy(s, slices, sizeof(s));
+
+        for (isize i = 0; i < 8; i++) {
+
+            u8 first = s[2 * i] & mask;
+            u8 second = s[2 * i + 1] & mask;
+            u8 &p = dBuffer[pixel + i];
+
+            p = u8((((p & keep1) | first << 2) & keep2) | second);
+        }
+
+    } else {
+
+        // Synthesize 32 lores pixels or 16 hires pixels
+        constexpr isize words = mode == LORES ? 4 : 2;
+        constexpr u64 keep = u64(~planes & 0x3F) * 0x0101010101010101;
+        u64 select = u64(mask) * 0x0101010101010101;
+
+        assert(pixel + 8 * words <= isizeof(dBuffer));
+
+        for (isize i = 0; i < words; i++) {
+
+            u64 word;
+            std::memcpy(&word, dBuffer + pixel + 8 * i, 8);
+            word = (word & keep) | (slices[i] & select);
+            std::memcpy(dBuffer + pixel + 8 * i, &word, 8);
+        }
     }
 }
 
@@ -245,52 +311,12 @@ Denise::drawOdd(Pixel offset)
         0b010101  // 6 bitplanes
     };
     
-    u16 mask = masks[bpu()];
+    u8 mask = u8(masks[bpu()]);
     Pixel pixel = agnus.pos.pixel() + offset + 2;
 
-    u8 slices[16];
-    extractSlicesOdd(slices);
-    
-    for (isize i = 0; i < 16; i++) {
-        
-        u8 index = slices[i] & mask;
-
-        switch (mode) {
-
-            case LORES:
-
-                // Synthesize two lores pixels
-                assert(pixel + 1 < isizeof(dBuffer));
-                dBuffer[pixel] = (dBuffer[pixel] & 0b101010) | index;
-                pixel++;
-                dBuffer[pixel] = (dBuffer[pixel] & 0b101010) | index;
-                pixel++;
-                break;
-
-            case HIRES:
-
-                // Synthesize one hires pixel
-                assert(pixel < isizeof(dBuffer));
-                dBuffer[pixel] = (dBuffer[pixel] & 0b101010) | index;
-                pixel++;
-                break;
-
-            case SHRES:
-
-                // Synthesize a superHires pixel
-                assert(pixel < isizeof(dBuffer));
-                if (i % 2 == 0) {
-                    dBuffer[pixel] = u8((dBuffer[pixel] & 0b111011) | index << 2);
-                } else {
-                    dBuffer[pixel] = u8((dBuffer[pixel] & 0b111110) | index);
-                    pixel++;
-                }
-                break;
-
-            default:
-                fatalError;
-        }
-    }
+    u64 slices[4];
+    extractSlices <mode, 0b010101> (slices);
+    mergeSlices <mode, 0b010101> (pixel, slices, mask);
 
     // Clear the shift registers
     shiftReg[0] = shiftReg[2] = shiftReg[4] = 0;
@@ -310,52 +336,12 @@ Denise::drawEven(Pixel offset)
         0b101010  // 6 bitplanes
     };
     
-    u16 mask = masks[bpu()];
+    u8 mask = u8(masks[bpu()]);
     Pixel pixel = agnus.pos.pixel() + offset + 2;
 
-    u8 slices[16];
-    extractSlicesEven(slices);
-    
-    for (isize i = 0; i < 16; i++) {
-
-        u8 index = slices[i] & mask;
-
-        switch (mode) {
-
-            case LORES:
-
-                // Synthesize s lores pixel
-                assert(pixel + 1 < isizeof(dBuffer));
-                dBuffer[pixel] = (dBuffer[pixel] & 0b010101) | index;
-                pixel++;
-                dBuffer[pixel] = (dBuffer[pixel] & 0b010101) | index;
-                pixel++;
-                break;
-
-            case HIRES:
-
-                // Synthesize a hires pixel
-                assert(pixel < isizeof(dBuffer));
-                dBuffer[pixel] = (dBuffer[pixel] & 0b010101) | index;
-                pixel++;
-                break;
-
-            case SHRES:
-
-                // Synthesize a superHires pixel
-                assert(pixel < isizeof(dBuffer));
-                if (i % 2 == 0) {
-                    dBuffer[pixel] = u8((dBuffer[pixel] & 0b110111) | index << 2);
-                } else {
-                    dBuffer[pixel] = u8((dBuffer[pixel] & 0b111101) | index);
-                    pixel++;
-                }
-                break;
-
-            default:
-                fatalError;
-        }
-    }
+    u64 slices[4];
+    extractSlices <mode, 0b101010> (slices);
+    mergeSlices <mode, 0b101010> (pixel, slices, mask);
 
     // Clear the shift registers
     shiftReg[1] = shiftReg[3] = shiftReg[5] = 0;
@@ -382,52 +368,12 @@ Denise::drawBoth(Pixel offset)
         0b111111  // 6 bitplanes
     };
 
-    u16 mask = masks[bpu()];
+    u8 mask = u8(masks[bpu()]);
     Pixel pixel = agnus.pos.pixel() + offset + 2;
 
-    u8 slices[16];
-    extractSlices(slices);
-
-    for (isize i = 0; i < 16; i++) {
-
-        u8 index = slices[i] & mask;
-
-        switch (mode) {
-
-            case LORES:
-
-                // Synthesize s lores pixel
-                assert(pixel + 1 < isizeof(dBuffer));
-                dBuffer[pixel] = index;
-                pixel++;
-                dBuffer[pixel] = index;
-                pixel++;
-                break;
-
-            case HIRES:
-
-                // Synthesize a hires pixel
-                assert(pixel < isizeof(dBuffer));
-                dBuffer[pixel] = index;
-                pixel++;
-                break;
-
-            case SHRES:
-
-                // Synthesize a superHires pixel
-                assert(pixel < isizeof(dBuffer));
-                if (i % 2 == 0) {
-                    dBuffer[pixel] = u8(index << 2);
-                } else {
-                    dBuffer[pixel] = u8(dBuffer[pixel] | index);
-                    pixel++;
-                }
-                break;
-
-            default:
-                fatalError;
-        }
-    }
+    u64 slices[4];
+    extractSlices <mode, 0b111111> (slices);
+    mergeSlices <mode, 0b111111> (pixel, slices, mask);
 
     // Clear the shift registers
     for (isize i = 0; i < 6; i++) shiftReg[i] = 0;
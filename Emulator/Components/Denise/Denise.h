@@ -521,10 +521,11 @@ public:
     void updateShiftRegistersOdd();
     void updateShiftRegistersEven();
 
-    // Extracts a bit slice from the shift registers
-    void extractSlices(u8 slices[16]);
-    void extractSlicesOdd(u8 slices[16]);
-    void extractSlicesEven(u8 slices[16]);
+    // Converts the shift registers into bitplane indices (one byte per pixel)
+    template <Resolution mode, u8 planes> void extractSlices(u64 slices[4]);
+
+    // Writes bitplane indices into the bitplane data buffer
+    template <Resolution mode, u8 planes> void mergeSlices(Pixel pixel, const u64 slices[4], u8 mask);
 
     
     //
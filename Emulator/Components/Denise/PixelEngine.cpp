@@ -410,7 +410,7 @@ PixelEngine::colorize(isize line)
     // Wipe out the HBLANK area
     auto start = agnus.pos.pixel(HBLANK_MIN);
     auto stop  = agnus.pos.pixel(HBLANK_MAX);
-    for (pixel = start; pixel <= stop; pixel++) dst[pixel] = FrameBuffer::hblank;
+    std::fill(dst + start, dst + stop + 1, FrameBuffer::hblank);
 }
 
 void
@@ -419,12 +419,36 @@ PixelEngine::colorize(Texel *dst, Pixel from, Pixel to)
     auto *mbuf = denise.mBuffer;
     auto *bbuf = denise.bBuffer;
 
-    /*
-    for (Pixel i = from; i < to; i++) {
-        dst[i] = palette[mbuf[i]];
+    Pixel i = from;
+
+    // Process chunks of 8 pixels. Most chunks are either free of border
+    // pixels or consist of border pixels only.
+    for (; i + 8 <= to; i += 8) {
+
+        u64 border;
+        std::memcpy(&border, bbuf + i, 8);
+
+        if (border == ~u64(0)) {
+
+            // No border pixels
+            for (isize j = 0; j < 8; j++) dst[i + j] = palette[mbuf[i + j]];
+
+        } else if (border == (border & 0xFF) * 0x0101010101010101) {
+
+            // Border pixels only
+            std::fill(dst + i, dst + i + 8, palette[border & 0xFF]);
+
+        } else {
+
+            // Mixed chunk
+            for (isize j = i; j < i + 8; j++) {
+                dst[j] = palette[bbuf[j] == 0xFF ? mbuf[j] : bbuf[j]];
+            }
+        }
     }
-    */
-    for (Pixel i = from; i < to; i++) {
+
+    // Process the remaining pixels
+    for (; i < to; i++) {
         dst[i] = palette[bbuf[i] == 0xFF ? mbuf[i] : bbuf[i]];
     }
 }
@@ -439,9 +463,7 @@ PixelEngine::colorizeSHRES(Texel *dst, Pixel from, Pixel to)
     if constexpr (sizeof(Texel) == 4) {
 
         // Output two super-hires pixels as a single texel
-        for (Pixel i = from; i < to; i++) {
-            dst[i] = palette[bbuf[i] == 0xFF ? mbuf[i] : bbuf[i]];
-        }
+        colorize(dst, from, to);
 
     } else {
 
@@ -472,56 +494,86 @@ PixelEngine::colorizeSHRES(Texel *dst, Pixel from, Pixel to)
 void
 PixelEngine::colorizeHAM(Texel *dst, Pixel from, Pixel to, AmigaColor& ham)
 {
+    /* The hold register is kept as a 12-bit RGB value. The four HAM control
+     * codes are handled without branching by combining the preserved bits
+     * of the hold register with the new bits:
+     *
+     *   00: Get color from register (keep nothing)
+     *   01: Modify blue             (keep red and green)
+     *   10: Modify red              (keep green and blue)
+     *   11: Modify green            (keep red and blue)
+     */
+    static constexpr u16 keep[4]  = { 0x000, 0xFF0, 0x0FF, 0xF0F };
+    static constexpr u8  shift[4] = { 0, 0, 8, 4 };
+
     auto *dbuf = denise.dBuffer;
     auto *ibuf = denise.iBuffer;
     auto *mbuf = denise.mBuffer;
     auto *bbuf = denise.bBuffer;
+    auto *zbuf = denise.zBuffer;
 
-    for (Pixel i = from; i < to; i++) {
+    // Cache the color registers in 12-bit RGB format
+    u16 regs[32];
+    for (isize j = 0; j < 32; j++) regs[j] = color[j].rawValue();
 
-        // Check for border pixels
-        if (bbuf[i] != 0xFF) {
+    u16 hold = ham.rawValue();
 
-            dst[i] = palette[bbuf[i]];
-            continue;
-        }
+    auto modify = [&](Pixel i) {
 
         u8 index = ibuf[i];
         assert(isPaletteIndex(index));
 
-        switch ((dbuf[i] >> 4) & 0b11) {
+        isize ctrl = (dbuf[i] >> 4) & 0b11;
+        u16 reg = regs[index & 0x1F];
+        u16 mod = u16((index & 0xF) << shift[ctrl]);
+        hold = (hold & keep[ctrl]) | (ctrl ? mod : reg);
+    };
+
+    Pixel i = from;
 
-            case 0b00: // Get color from register
+    while (i < to) {
 
-                ham = color[index];
-                break;
+        // Check if the next 8 pixels contain neither border nor sprite pixels
+        if (i + 8 <= to) {
 
-            case 0b01: // Modify blue
+            u64 border;
+            std::memcpy(&border, bbuf + i, 8);
 
-                ham.b = index & 0xF;
-                break;
+            u16 sprites = 0;
+            for (isize j = 0; j < 8; j++) sprites |= zbuf[i + j] & Denise::Z_SP01234567;
 
-            case 0b10: // Modify red
+            if (border == ~u64(0) && !sprites) {
 
-                ham.r = index & 0xF;
-                break;
+                // Resolve the chunk with a tight loop
+                for (isize j = 0; j < 8; j++, i++) {
 
-            case 0b11: // Modify green
+                    modify(i);
+                    dst[i] = colorSpace[hold];
+                }
+                continue;
+            }
+        }
 
-                ham.g = index & 0xF;
-                break;
+        // Check for border pixels
+        if (bbuf[i] != 0xFF) {
 
-            default:
-                fatalError;
+            dst[i] = palette[bbuf[i]];
+            i++;
+            continue;
         }
 
+        modify(i);
+
         // Synthesize pixel
-        if (denise.spritePixelIsVisible(i)) {
+        if (Denise::isSpritePixel(zbuf[i])) {
             dst[i] = palette[mbuf[i]];
         } else {
-            dst[i] = colorSpace[ham.rawValue()];
+            dst[i] = colorSpace[hold];
         }
+        i++;
     }
+
+    ham = AmigaColor(hold);
 }
 
 void
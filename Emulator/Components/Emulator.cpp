@@ -141,6 +141,13 @@ Emulator::_dump(Category category, std::ostream& os) const
         os << std::endl;
         os << tab("Refresh rate");
         os << dec(isize(refreshRate())) << " Fps" << std::endl;
+        os << std::endl;
+        os << tab("Run-ahead clones");
+        os << dec(clones) << std::endl;
+        os << tab("Latest clone");
+        os << dec(cloneBytes) << " Bytes in " << dec(cloneTime) << " usec" << std::endl;
+        os << std::endl;
+        rewinder.dump(category, os);
     }
 }
 
@@ -168,6 +175,9 @@ Emulator::cacheStats(EmulatorStats &result) const
         result.cpuLoad = cpuLoad;
         result.fps = fps;
         result.resyncs = resyncs;
+        result.clones = clones;
+        result.cloneBytes = cloneBytes;
+        result.cloneTime = cloneTime;
     }
 
 }
@@ -362,6 +372,32 @@ Emulator::stepOver()
     run();
 }
 
+isize
+Emulator::rewind(isize frames)
+{
+    isize result = 0;
+
+    {   SUSPENDED
+
+        try {
+
+            result = rewinder.rewind(main, frames);
+
+        } catch (Error &error) {
+
+            // The recording is corrupted. Discard it and keep the current state
+            rewinder.clear();
+            throw error;
+        }
+
+        // The run-ahead instance is outdated now
+        isDirty = true;
+    }
+
+    if (result) main.msgQueue.put(MSG_SNAPSHOT_RESTORED);
+    return result;
+}
+
 void
 Emulator::computeFrame()
 {
@@ -391,16 +427,34 @@ Emulator::computeFrame()
         // Only run the main instance
         main.computeFrame();
     }
+
+    // Record the frame for rewinding
+    if (config.rewind) {
+
+        auto frames = isize(config.rewind * main.nativeRefreshRate());
+        rewinder.record(main, frames, MB(config.rewindBudget));
+
+    } else {
+
+        rewinder.clear();
+    }
 }
 
 void 
 Emulator::cloneRunAheadInstance()
 {
-    // clones++;
+    util::Clock clock;
 
-    // Recreate the runahead instance from scratch
+    // Recreate the runahead instance (only modified data is copied)
     ahead = main; isDirty = false;
 
+    // Record statistics
+    clones++;
+    cloneBytes = ahead.mem.getClonedBytes();
+    for (auto &df : ahead.df) if (df->disk) cloneBytes += df->disk->getClonedBytes();
+    for (auto &hd : ahead.hd) cloneBytes += hd->getClonedBytes();
+    cloneTime = isize(clock.stop().asMicroseconds());
+
     if (RUA_CHECKSUM && ahead != main) {
 
         main.diff(ahead);
@@ -481,6 +535,7 @@ Emulator::getDebugVariable(DebugFlag flag)
         case FLAG_COP_CHECKSUM:     return COP_CHECKSUM;
         case FLAG_COPREG_DEBUG:     return COPREG_DEBUG;
         case FLAG_COP_DEBUG:        return COP_DEBUG;
+        case FLAG_COP_ON_STEROIDS:  return COP_ON_STEROIDS;
 
         case FLAG_BLT_CHECKSUM:     return BLT_CHECKSUM;
         case FLAG_BLTREG_DEBUG:     return BLTREG_DEBUG;
@@ -614,6 +669,7 @@ Emulator::setDebugVariable(DebugFlag flag, bool val)
         case FLAG_COP_CHECKSUM:     COP_CHECKSUM = val; break;
         case FLAG_COPREG_DEBUG:     COPREG_DEBUG = val; break;
         case FLAG_COP_DEBUG:        COP_DEBUG = val; break;
+        case FLAG_COP_ON_STEROIDS:  COP_ON_STEROIDS = val; break;
 
             // Blitter
         case FLAG_BLT_CHECKSUM:     BLT_CHECKSUM = val; break;
@@ -15,6 +15,7 @@
 #include "Host.h"
 #include "Thread.h"
 #include "CmdQueue.h"
+#include "Rewinder.h"
 
 namespace vamiga {
 
@@ -34,6 +35,14 @@ public:
     // Indicates if the run-ahead instance needs to be updated
     bool isDirty = true;
 
+    // Run-ahead statistics
+    isize clones = 0;
+    isize cloneBytes = 0;
+    isize cloneTime = 0;
+
+    // Recording of the most recent frames
+    Rewinder rewinder;
+
 public:
 
     // User default settings
@@ -168,6 +177,9 @@ public:
     void stepInto();
     void stepOver();
 
+    // Steps back in time (returns the number of rewound frames)
+    isize rewind(isize frames = 1) throws;
+
 
     //
     // Audio and Video
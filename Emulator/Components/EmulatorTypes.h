@@ -62,6 +62,7 @@ enum_long(DEBUG_FLAG)
     FLAG_COP_CHECKSUM,     ///< Compute Copper checksums
     FLAG_COPREG_DEBUG,     ///< Copper registers
     FLAG_COP_DEBUG,        ///< Copper execution
+    FLAG_COP_ON_STEROIDS,  ///< Disable Copper fast-paths
 
     // Blitter
     FLAG_BLT_CHECKSUM,     ///< Compute Blitter checksums
@@ -206,6 +207,7 @@ struct DebugFlagEnum : vamiga::util::Reflection<DebugFlagEnum, DebugFlag>
             case FLAG_COP_CHECKSUM:     return "COP_CHECKSUM";
             case FLAG_COPREG_DEBUG:     return "COPREG_DEBUG";
             case FLAG_COP_DEBUG:        return "COP_DEBUG";
+            case FLAG_COP_ON_STEROIDS:  return "COP_ON_STEROIDS";
 
                 // Blitter
             case FLAG_BLT_CHECKSUM:     return "BLT_CHECKSUM";
@@ -339,6 +341,7 @@ struct DebugFlagEnum : vamiga::util::Reflection<DebugFlagEnum, DebugFlag>
             case FLAG_COP_CHECKSUM:     return "Compute Copper checksums";
             case FLAG_COPREG_DEBUG:     return "Copper registers";
             case FLAG_COP_DEBUG:        return "Copper execution";
+            case FLAG_COP_ON_STEROIDS:  return "Disable Copper fast-paths";
 
                 // Blitter
             case FLAG_BLT_CHECKSUM:     return "Compute Blitter checksums";
@@ -458,6 +461,9 @@ typedef struct
     double cpuLoad;         ///< Measured CPU load
     double fps;             ///< Measured frames per seconds
     isize resyncs;          ///< Number of out-of-sync conditions
+    isize clones;           ///< Number of run-ahead clones
+    isize cloneBytes;       ///< Bytes copied by the latest clone
+    isize cloneTime;        ///< Duration of the latest clone in microseconds
 }
 EmulatorStats;
 
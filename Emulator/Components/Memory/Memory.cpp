@@ -33,6 +33,81 @@ Memory::Memory(Amiga& ref) : SubComponent(ref)
     };
 }
 
+Memory&
+Memory::operator= (const Memory& other) {
+
+    clonedBytes = 0;
+
+    if (RUA_ON_STEROIDS) {
+
+        // Clone all pages
+        CLONE(romAllocator)
+        CLONE(womAllocator)
+        CLONE(extAllocator)
+        CLONE(chipAllocator)
+        CLONE(slowAllocator)
+        CLONE(fastAllocator)
+
+        clonedBytes =
+        romAllocator.size + womAllocator.size + extAllocator.size +
+        chipAllocator.size + slowAllocator.size + fastAllocator.size;
+
+    } else {
+
+        // Clone modified pages
+        clone(romAllocator, romStamps, other.romAllocator, other.romStamps);
+        clone(womAllocator, womStamps, other.womAllocator, other.womStamps);
+        clone(extAllocator, extStamps, other.extAllocator, other.extStamps);
+        clone(chipAllocator, chipStamps, other.chipAllocator, other.chipStamps);
+        clone(slowAllocator, slowStamps, other.slowAllocator, other.slowStamps);
+        clone(fastAllocator, fastStamps, other.fastAllocator, other.fastStamps);
+    }
+
+    CLONE(womIsLocked)
+    CLONE_ARRAY(cpuMemSrc)
+    CLONE_ARRAY(agnusMemSrc)
+    CLONE(dataBus)
+
+    CLONE(romMask)
+    CLONE(womMask)
+    CLONE(extMask)
+    CLONE(chipMask)
+
+    CLONE(config)
+
+    // The page table points into the memory of this instance
+    updateCpuPageTable();
+
+    // Continue in the epoch of the source instance
+    CLONE(epoch)
+    syncEpoch = other.epoch;
+
+    return *this;
+}
+
+void
+Memory::clone(Allocator<u8> &allocator, u32 *stamps,
+              const Allocator<u8> &other, const u32 *otherStamps)
+{
+    // Copy everything if the memory layout has changed
+    if (allocator.size != other.size) {
+
+        allocator = other;
+        clonedBytes += other.size;
+        return;
+    }
+
+    for (isize i = 0, page = 0; i < other.size; i += MEM_PAGE_SIZE, page++) {
+
+        if (stamps[page] >= syncEpoch || otherStamps[page] >= syncEpoch) {
+
+            auto len = std::min(isize(MEM_PAGE_SIZE), other.size - i);
+            std::memcpy(allocator.ptr + i, other.ptr + i, len);
+            clonedBytes += len;
+        }
+    }
+}
+
 void
 Memory::_dump(Category category, std::ostream& os) const
 {
@@ -341,6 +416,7 @@ Memory::operator << (SerCounter &worker)
     i32 fastSize = config.fastSize;
 
     serialize(worker);
+    if (skipsBulkData(worker)) return;
 
     worker
     << romSize
@@ -364,6 +440,13 @@ Memory::operator << (SerReader &worker)
     i32 romSize, womSize, extSize, chipSize, slowSize, fastSize;
 
     serialize(worker);
+
+    if (skipsBulkData(worker)) {
+
+        // Keep the memory contents
+        updateCpuPageTable();
+        return;
+    }
     
     // Load memory size information
     worker
@@ -399,12 +482,16 @@ Memory::operator << (SerReader &worker)
     worker.copy(chip, chipSize);
     worker.copy(slow, slowSize);
     worker.copy(fast, fastSize);
+
+    touchAll();
+    updateCpuPageTable();
 }
 
 void
 Memory::operator << (SerWriter &worker)
 {
     serialize(worker);
+    if (skipsBulkData(worker)) return;
 
     // Determine memory size information
     i32 romSize = config.saveRoms ? config.romSize : 0;
@@ -503,6 +590,8 @@ Memory::cacheStats(MemStats &result) const
     result.fastWrites.raw = 0;
     result.kickReads.raw = 0;
     result.kickWrites.raw = 0;
+
+    result.sampled = !MEM_STATS;
 }
 
 void
@@ -555,6 +644,8 @@ Memory::alloc(Allocator<u8> &allocator, isize bytes, bool update)
 
     // Allocate memory
     allocator.alloc(bytes);
+    touchAll();
+    updateCpuPageTable();
 
     // Update the memory source tables if requested
     if (update) updateMemSrcTables();
@@ -602,6 +693,130 @@ Memory::fillRamWithInitPattern()
         default:
             break;
     }
+
+    touchAll();
+}
+
+void
+Memory::touchAll()
+{
+    for (auto &stamp : romStamps) stamp = epoch;
+    for (auto &stamp : womStamps) stamp = epoch;
+    for (auto &stamp : extStamps) stamp = epoch;
+    for (auto &stamp : chipStamps) stamp = epoch;
+    for (auto &stamp : slowStamps) stamp = epoch;
+    for (auto &stamp : fastStamps) stamp = epoch;
+}
+
+void
+Memory::touchChip(u32 first, u32 last)
+{
+    assert((first & ~chipMask) == (last & ~chipMask));
+
+    auto p1 = (first & chipMask) >> MEM_PAGE_SHIFT;
+    auto p2 = (last & chipMask) >> MEM_PAGE_SHIFT;
+
+    for (auto p = p1; p <= p2; p++) chipStamps[p] = epoch;
+}
+
+u8 *
+Memory::rawChipPtr(u32 addr, isize &bytes) const
+{
+    assert((addr & agnus.ptrMask) == addr);
+    assert(bytes > 0);
+
+    // The block must neither wrap around nor leave the current Chip Ram mirror
+    i64 lo = addr;
+    i64 hi = std::min({ lo + bytes, i64(agnus.ptrMask) + 1, (lo | chipMask) + 1 });
+
+    // The block must be located in Chip Ram
+    for (i64 bank = lo >> 16; bank <= (hi - 1) >> 16; bank++) {
+
+        if (agnusMemSrc[bank] != MEM_CHIP) {
+            hi = bank << 16;
+            break;
+        }
+    }
+    if (hi <= lo) return nullptr;
+
+    bytes = isize(hi - lo);
+    return chip + (addr & chipMask);
+}
+
+void
+Memory::touchPage(MemorySource src, isize page)
+{
+    assert(page >= 0 && page < numPages(src));
+
+    const_cast<u32 *>(getStamps(src))[page] = epoch;
+}
+
+isize
+Memory::numPages(MemorySource src) const
+{
+    auto pages = [](isize bytes) { return (bytes + MEM_PAGE_SIZE - 1) >> MEM_PAGE_SHIFT; };
+
+    switch (src) {
+
+        case MEM_CHIP:  return pages(config.chipSize);
+        case MEM_SLOW:  return pages(config.slowSize);
+        case MEM_FAST:  return pages(config.fastSize);
+        case MEM_ROM:   return pages(config.romSize);
+        case MEM_WOM:   return pages(config.womSize);
+        case MEM_EXT:   return pages(config.extSize);
+
+        default:
+            return 0;
+    }
+}
+
+const u32 *
+Memory::getStamps(MemorySource src) const
+{
+    switch (src) {
+
+        case MEM_CHIP:  return chipStamps;
+        case MEM_SLOW:  return slowStamps;
+        case MEM_FAST:  return fastStamps;
+        case MEM_ROM:   return romStamps;
+        case MEM_WOM:   return womStamps;
+        case MEM_EXT:   return extStamps;
+
+        default:
+            return nullptr;
+    }
+}
+
+bool
+Memory::isModified(MemorySource src, isize page, u32 since) const
+{
+    assert(page >= 0 && page < numPages(src));
+
+    return getStamps(src)[page] > since;
+}
+
+std::vector<bool>
+Memory::modifiedPages(MemorySource src, u32 since) const
+{
+    auto count = numPages(src);
+    auto stamps = getStamps(src);
+
+    std::vector<bool> result(count);
+    for (isize i = 0; i < count; i++) result[i] = stamps[i] > since;
+
+    return result;
+}
+
+isize
+Memory::countModifiedPages(MemorySource src, u32 since) const
+{
+    auto count = numPages(src);
+    auto stamps = getStamps(src);
+
+    isize result = 0;
+    for (isize i = 0; i < count; i++) if (stamps[i] > since) result++;
+
+    return result;
 }
 
 RomTraits &
@@ -680,6 +895,8 @@ Memory::loadRom(MediaFile &file)
         // Remove extended Rom (if any)
         deleteExt();
 
+        touchAll();
+
     } catch (...) { try {
 
         auto &extFile = dynamic_cast<ExtendedRomFile &>(file);
@@ -689,6 +906,7 @@ Memory::loadRom(MediaFile &file)
 
         // Load Rom
         extFile.flash(ext);
+        touchAll();
 
     } catch (...) {
 
@@ -722,6 +940,7 @@ Memory::loadExt(MediaFile &file)
 
         // Load Rom
         file.flash(ext);
+        touchAll();
 
     } catch (...) {
 
@@ -796,6 +1015,7 @@ Memory::patchExpansionLib()
 
                     W32BE(rom + i, 0x426f0004);
                     W16BE(rom + i + 22, 0x0000);
+                    touchAll();
                     return;
                 }
             }
@@ -943,9 +1163,64 @@ Memory::updateCpuMemSrcTable()
     // Expansion boards
     zorro.updateMemSrcTables();
 
+    // Update the direct-mapped page table
+    updateCpuPageTable();
+
     msgQueue.put(MSG_MEM_LAYOUT);
 }
 
+void
+Memory::updateCpuPageTable()
+{
+    // Returns the first byte of a bank in a Rom-like area or nullptr
+    auto romPage = [&](u8 *base, u32 mask, u32 bank) -> u8 * {
+        return base && (mask & 0xFFFF) == 0xFFFF ? base + (bank & mask) : nullptr;
+    };
+
+    for (isize i = 0; i <= 0xFF; i++) {
+
+        u32 bank = u32(i << 16);
+
+        cpuReadPage[i] = nullptr;
+        cpuWritePage[i] = nullptr;
+        cpuReadCounter[i] = nullptr;
+
+        switch (cpuMemSrc[i]) {
+
+            case MEM_FAST:
+
+                if (bank >= FAST_RAM_STRT && bank - FAST_RAM_STRT + 0x10000 <= fastAllocator.size) {
+
+                    cpuReadPage[i] = cpuWritePage[i] = fast + (bank - FAST_RAM_STRT);
+                    cpuReadCounter[i] = &stats.fastReads.raw;
+                }
+                break;
+
+            case MEM_ROM:
+            case MEM_ROM_MIRROR:
+
+                cpuReadPage[i] = romPage(rom, romMask, bank);
+                cpuReadCounter[i] = &stats.kickReads.raw;
+                break;
+
+            case MEM_WOM:
+
+                cpuReadPage[i] = romPage(wom, womMask, bank);
+                cpuReadCounter[i] = &stats.kickReads.raw;
+                break;
+
+            case MEM_EXT:
+
+                cpuReadPage[i] = romPage(ext, extMask, bank);
+                cpuReadCounter[i] = &stats.kickReads.raw;
+                break;
+
+            default:
+                break;
+        }
+    }
+}
+
 void
 Memory::updateAgnusMemSrcTable()
 {
@@ -1094,7 +1369,7 @@ Memory::peek8 <ACCESSOR_CPU, MEM_CHIP> (u32 addr)
     ASSERT_CHIP_ADDR(addr);
     agnus.executeUntilBusIsFree();
     
-    stats.chipReads.raw++;
+    COUNT_ACCESS(chipReads);
     dataBus = READ_CHIP_8(addr);
     return (u8)dataBus;
 }
@@ -1105,7 +1380,7 @@ Memory::peek16 <ACCESSOR_CPU, MEM_CHIP> (u32 addr)
     ASSERT_CHIP_ADDR(addr);
     agnus.executeUntilBusIsFree();
     
-    stats.chipReads.raw++;
+    COUNT_ACCESS(chipReads);
     dataBus = READ_CHIP_16(addr);
     return dataBus;
 }
@@ -1122,7 +1397,7 @@ Memory::peek8 <ACCESSOR_CPU, MEM_SLOW> (u32 addr)
     ASSERT_SLOW_ADDR(addr);
     agnus.executeUntilBusIsFree();
     
-    stats.slowReads.raw++;
+    COUNT_ACCESS(slowReads);
     dataBus = READ_SLOW_8(addr);
     return (u8)dataBus;
 }
@@ -1133,7 +1408,7 @@ Memory::peek16 <ACCESSOR_CPU, MEM_SLOW> (u32 addr)
     ASSERT_SLOW_ADDR(addr);
     agnus.executeUntilBusIsFree();
     
-    stats.slowReads.raw++;
+    COUNT_ACCESS(slowReads);
     dataBus = READ_SLOW_16(addr);
     return dataBus;
 }
@@ -1149,7 +1424,7 @@ Memory::peek8 <ACCESSOR_CPU, MEM_FAST> (u32 addr)
 {
     ASSERT_FAST_ADDR(addr);
     
-    stats.fastReads.raw++;
+    COUNT_ACCESS(fastReads);
     return READ_FAST_8(addr);
 }
 
@@ -1162,7 +1437,7 @@ Memory::peek16 <ACCESSOR_CPU, MEM_FAST> (u32 addr)
     
     ASSERT_FAST_ADDR(addr);
     
-    stats.fastReads.raw++;
+    COUNT_ACCESS(fastReads);
     return READ_FAST_16(addr);
 }
 
@@ -1325,7 +1600,7 @@ Memory::peek8 <ACCESSOR_CPU, MEM_ROM> (u32 addr)
 {
     ASSERT_ROM_ADDR(addr);
     
-    stats.kickReads.raw++;
+    COUNT_ACCESS(kickReads);
     return READ_ROM_8(addr);
 }
 
@@ -1334,7 +1609,7 @@ Memory::peek16 <ACCESSOR_CPU, MEM_ROM> (u32 addr)
 {
     ASSERT_ROM_ADDR(addr);
     
-    stats.kickReads.raw++;
+    COUNT_ACCESS(kickReads);
     return READ_ROM_16(addr);
 }
 
@@ -1349,7 +1624,7 @@ Memory::peek8 <ACCESSOR_CPU, MEM_WOM> (u32 addr)
 {
     ASSERT_WOM_ADDR(addr);
     
-    stats.kickReads.raw++;
+    COUNT_ACCESS(kickReads);
     return READ_WOM_8(addr);
 }
 
@@ -1358,7 +1633,7 @@ Memory::peek16 <ACCESSOR_CPU, MEM_WOM> (u32 addr)
 {
     ASSERT_WOM_ADDR(addr);
     
-    stats.kickReads.raw++;
+    COUNT_ACCESS(kickReads);
     return READ_WOM_16(addr);
 }
 
@@ -1373,7 +1648,7 @@ Memory::peek8 <ACCESSOR_CPU, MEM_EXT> (u32 addr)
 {
     ASSERT_EXT_ADDR(addr);
     
-    stats.kickReads.raw++;
+    COUNT_ACCESS(kickReads);
     return READ_EXT_8(addr);
 }
 
@@ -1382,7 +1657,7 @@ Memory::peek16 <ACCESSOR_CPU, MEM_EXT> (u32 addr)
 {
     ASSERT_EXT_ADDR(addr);
     
-    stats.kickReads.raw++;
+    COUNT_ACCESS(kickReads);
     return READ_EXT_16(addr);
 }
 
@@ -1396,7 +1671,14 @@ template<> u8
 Memory::peek8 <ACCESSOR_CPU> (u32 addr)
 {
     addr &= 0xFFFFFF;
-    
+
+    // Read directly from memory if the bank has no side effects
+    if (auto page = cpuReadPage[addr >> 16]) {
+
+        if constexpr (MEM_STATS) (*cpuReadCounter[addr >> 16])++;
+        return R8BE(page + (addr & 0xFFFF));
+    }
+
     switch (cpuMemSrc[addr >> 16]) {
             
         case MEM_NONE:          return peek8 <ACCESSOR_CPU, MEM_NONE>     (addr);
@@ -1426,6 +1708,13 @@ Memory::peek16 <ACCESSOR_CPU> (u32 addr)
 {
     addr &= 0xFFFFFF;
 
+    // Read directly from memory if the bank has no side effects
+    if (auto page = cpuReadPage[addr >> 16]) {
+
+        if constexpr (MEM_STATS) (*cpuReadCounter[addr >> 16])++;
+        return R16BE(page + (addr & 0xFFFF));
+    }
+
     switch (cpuMemSrc[addr >> 16]) {
             
         case MEM_NONE:          return peek16 <ACCESSOR_CPU, MEM_NONE>     (addr);
@@ -1625,7 +1914,7 @@ Memory::poke8 <ACCESSOR_CPU, MEM_CHIP> (u32 addr, u8 value)
 
     agnus.executeUntilBusIsFree();
     
-    stats.chipWrites.raw++;
+    COUNT_ACCESS(chipWrites);
     dataBus = value;
     WRITE_CHIP_8(addr, value);
 }
@@ -1643,7 +1932,7 @@ Memory::poke16 <ACCESSOR_CPU, MEM_CHIP> (u32 addr, u16 value)
 
     agnus.executeUntilBusIsFree();
     
-    stats.chipWrites.raw++;
+    COUNT_ACCESS(chipWrites);
     dataBus = value;
     WRITE_CHIP_16(addr, value);
 }
@@ -1655,7 +1944,7 @@ Memory::poke8 <ACCESSOR_CPU, MEM_SLOW> (u32 addr, u8 value)
     
     agnus.executeUntilBusIsFree();
     
-    stats.slowWrites.raw++;
+    COUNT_ACCESS(slowWrites);
     dataBus = value;
     WRITE_SLOW_8(addr, value);
 }
@@ -1667,7 +1956,7 @@ Memory::poke16 <ACCESSOR_CPU, MEM_SLOW> (u32 addr, u16 value)
     
     agnus.executeUntilBusIsFree();
     
-    stats.slowWrites.raw++;
+    COUNT_ACCESS(slowWrites);
     dataBus = value;
     WRITE_SLOW_16(addr, value);
 }
@@ -1677,7 +1966,7 @@ Memory::poke8 <ACCESSOR_CPU, MEM_FAST> (u32 addr, u8 value)
 {
     ASSERT_FAST_ADDR(addr);
     
-    stats.fastWrites.raw++;
+    COUNT_ACCESS(fastWrites);
     WRITE_FAST_8(addr, value);
 }
 
@@ -1686,7 +1975,7 @@ Memory::poke16 <ACCESSOR_CPU, MEM_FAST> (u32 addr, u16 value)
 {
     ASSERT_FAST_ADDR(addr);
     
-    stats.fastWrites.raw++;
+    COUNT_ACCESS(fastWrites);
     WRITE_FAST_16(addr, value);
 }
 
@@ -1796,7 +2085,7 @@ Memory::poke8 <ACCESSOR_CPU, MEM_ROM> (u32 addr, u8 value)
 {
     ASSERT_ROM_ADDR(addr);
     
-    stats.kickWrites.raw++;
+    COUNT_ACCESS(kickWrites);
     
     // On Amigas with a WOM, writing into ROM space locks the WOM
     if (hasWom() && !womIsLocked) {
@@ -1817,7 +2106,7 @@ Memory::poke8 <ACCESSOR_CPU, MEM_WOM> (u32 addr, u8 value)
 {
     ASSERT_WOM_ADDR(addr);
     
-    stats.kickWrites.raw++;
+    COUNT_ACCESS(kickWrites);
     if (!womIsLocked) WRITE_WOM_8(addr, value);
 }
 
@@ -1826,7 +2115,7 @@ Memory::poke16 <ACCESSOR_CPU, MEM_WOM> (u32 addr, u16 value)
 {
     ASSERT_WOM_ADDR(addr);
 
-    stats.kickWrites.raw++;
+    COUNT_ACCESS(kickWrites);
     if (!womIsLocked) WRITE_WOM_16(addr, value);
 }
 
@@ -1834,21 +2123,30 @@ template <> void
 Memory::poke8 <ACCESSOR_CPU, MEM_EXT> (u32 addr, u8 value)
 {
     ASSERT_EXT_ADDR(addr);
-    stats.kickWrites.raw++;
+    COUNT_ACCESS(kickWrites);
 }
 
 template <> void
 Memory::poke16 <ACCESSOR_CPU, MEM_EXT> (u32 addr, u16 value)
 {
     ASSERT_EXT_ADDR(addr);
-    stats.kickWrites.raw++;
+    COUNT_ACCESS(kickWrites);
 }
 
 template<> void
 Memory::poke8 <ACCESSOR_CPU> (u32 addr, u8 value)
 {
     addr &= 0xFFFFFF;
-    
+
+    // Write directly into Fast Ram
+    if (auto page = cpuWritePage[addr >> 16]) {
+
+        COUNT_ACCESS(fastWrites);
+        W8BE(page + (addr & 0xFFFF), value);
+        TOUCH_FAST(addr);
+        return;
+    }
+
     switch (cpuMemSrc[addr >> 16]) {
             
         case MEM_NONE:          poke8 <ACCESSOR_CPU, MEM_NONE>     (addr, value); return;
@@ -1877,7 +2175,16 @@ template<> void
 Memory::poke16 <ACCESSOR_CPU> (u32 addr, u16 value)
 {
     addr &= 0xFFFFFF;
-    
+
+    // Write directly into Fast Ram
+    if (auto page = cpuWritePage[addr >> 16]) {
+
+        COUNT_ACCESS(fastWrites);
+        W16BE(page + (addr & 0xFFFF), value);
+        TOUCH_FAST(addr);
+        return;
+    }
+
     switch (cpuMemSrc[addr >> 16]) {
             
         case MEM_NONE:          poke16 <ACCESSOR_CPU, MEM_NONE>     (addr, value); return;
@@ -2749,7 +3056,7 @@ Memory::patch(u32 addr, u32 value)
 }
 
 void
-Memory::patch(u32 addr, u8 *buf, isize len)
+Memory::patch(u32 addr, const u8 *buf, isize len)
 {
     assert(buf);
     
@@ -2758,11 +3065,65 @@ Memory::patch(u32 addr, u8 *buf, isize len)
     }
 }
 
+void
+Memory::eolHandler()
+{
+    if constexpr (!MEM_STATS) {
+
+        /* If the access counters are compiled out, the statistics are
+         * estimated by sampling. CPU accesses to Chip Ram or Slow Ram are
+         * taken from the bus usage table. Accesses to Fast Ram or Rom are
+         * estimated by assuming that the CPU accesses the bank it executes
+         * from in every other free bus cycle. Since the bus usage table does
+         * not distinguish reads from writes, all sampled accesses are counted
+         * as reads and the write counters remain zero (see MemStats::sampled).
+         */
+        isize cpuCycles = 0, idleCycles = 0;
+        for (isize i = 0; i < agnus.pos.h; i++) {
+
+            cpuCycles += agnus.busOwner[i] == BUS_CPU;
+            idleCycles += agnus.busOwner[i] == BUS_NONE;
+        }
+        idleCycles /= 2;
+
+        switch (cpuMemSrc[(cpu.getPC0() >> 16) & 0xFF]) {
+
+            case MEM_SLOW:
+
+                stats.slowReads.raw += cpuCycles;
+                break;
+
+            case MEM_FAST:
+
+                stats.chipReads.raw += cpuCycles;
+                stats.fastReads.raw += idleCycles;
+                break;
+
+            case MEM_ROM:
+            case MEM_ROM_MIRROR:
+            case MEM_WOM:
+            case MEM_EXT:
+
+                stats.chipReads.raw += cpuCycles;
+                stats.kickReads.raw += idleCycles;
+                break;
+
+            default:
+
+                stats.chipReads.raw += cpuCycles;
+                break;
+        }
+    }
+}
+
 void 
 Memory::eofHandler()
 {
     // Update statistics
     (void)getStats();
+
+    // Start a new epoch
+    epoch++;
 }
 
 std::vector <u32>
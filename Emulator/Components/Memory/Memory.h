@@ -23,6 +23,10 @@ using util::Buffer;
 #define SLOW_RAM_STRT 0xC00000
 #define FAST_RAM_STRT ramExpansion.getBaseAddr()
 
+// Granularity of the page modification tracker (4 KB pages)
+#define MEM_PAGE_SHIFT 12
+#define MEM_PAGE_SIZE (1 << MEM_PAGE_SHIFT)
+
 // Verifies address ranges
 #define ASSERT_CHIP_ADDR(x) \
 assert(((x) % config.chipSize) == ((x) & chipMask));
@@ -73,33 +77,52 @@ assert((x) >= 0xE80000 && (x) <= 0xE8FFFF);
 #define READ_EXT_8(x)       R8BE (ext + ((x) & extMask))
 #define READ_EXT_16(x)      R16BE(ext + ((x) & extMask))
 
+//
+// Tracking modifications
+//
+
+// Stamps the page containing a certain address with the current epoch
+#define TOUCH_CHIP(x)       chipStamps[((x) & chipMask) >> MEM_PAGE_SHIFT] = epoch
+#define TOUCH_FAST(x)       fastStamps[((x) - FAST_RAM_STRT) >> MEM_PAGE_SHIFT] = epoch
+#define TOUCH_SLOW(x)       slowStamps[((x) - SLOW_RAM_STRT) >> MEM_PAGE_SHIFT] = epoch
+#define TOUCH_ROM(x)        romStamps[((x) & romMask) >> MEM_PAGE_SHIFT] = epoch
+#define TOUCH_WOM(x)        womStamps[((x) & womMask) >> MEM_PAGE_SHIFT] = epoch
+#define TOUCH_EXT(x)        extStamps[((x) & extMask) >> MEM_PAGE_SHIFT] = epoch
+
+//
+// Gathering statistics
+//
+
+// Counts a memory access (compiled out if MEM_STATS is 0)
+#define COUNT_ACCESS(x)     { if constexpr (MEM_STATS) stats.x.raw++; }
+
 //
 // Writing
 //
 
 // Writes a value into Chip RAM in big endian format
-#define WRITE_CHIP_8(x,y)   W8BE (chip + ((x) & chipMask), (y))
-#define WRITE_CHIP_16(x,y)  W16BE(chip + ((x) & chipMask), (y))
+#define WRITE_CHIP_8(x,y)   { W8BE (chip + ((x) & chipMask), (y)); TOUCH_CHIP(x); }
+#define WRITE_CHIP_16(x,y)  { W16BE(chip + ((x) & chipMask), (y)); TOUCH_CHIP(x); }
 
 // Writes a value into Fast RAM in big endian format
-#define WRITE_FAST_8(x,y)   W8BE (fast + ((x) - FAST_RAM_STRT), (y))
-#define WRITE_FAST_16(x,y)  W16BE(fast + ((x) - FAST_RAM_STRT), (y))
+#define WRITE_FAST_8(x,y)   { W8BE (fast + ((x) - FAST_RAM_STRT), (y)); TOUCH_FAST(x); }
+#define WRITE_FAST_16(x,y)  { W16BE(fast + ((x) - FAST_RAM_STRT), (y)); TOUCH_FAST(x); }
 
 // Writes a value into Slow RAM in big endian format
-#define WRITE_SLOW_8(x,y)   W8BE (slow + ((x) - SLOW_RAM_STRT), (y))
-#define WRITE_SLOW_16(x,y)  W16BE(slow + ((x) - SLOW_RAM_STRT), (y))
+#define WRITE_SLOW_8(x,y)   { W8BE (slow + ((x) - SLOW_RAM_STRT), (y)); TOUCH_SLOW(x); }
+#define WRITE_SLOW_16(x,y)  { W16BE(slow + ((x) - SLOW_RAM_STRT), (y)); TOUCH_SLOW(x); }
 
 // Writes a value into Boot ROM or Kickstart ROM in big endian format
-#define WRITE_ROM_8(x,y)    W8BE (rom + ((x) & romMask), (y))
-#define WRITE_ROM_16(x,y)   W16BE(rom + ((x) & romMask), (y))
+#define WRITE_ROM_8(x,y)    { W8BE (rom + ((x) & romMask), (y)); TOUCH_ROM(x); }
+#define WRITE_ROM_16(x,y)   { W16BE(rom + ((x) & romMask), (y)); TOUCH_ROM(x); }
 
 // Writes a value into Kickstart WOM in big endian format
-#define WRITE_WOM_8(x,y)    W8BE (wom + ((x) & womMask), (y))
-#define WRITE_WOM_16(x,y)   W16BE(wom + ((x) & womMask), (y))
+#define WRITE_WOM_8(x,y)    { W8BE (wom + ((x) & womMask), (y)); TOUCH_WOM(x); }
+#define WRITE_WOM_16(x,y)   { W16BE(wom + ((x) & womMask), (y)); TOUCH_WOM(x); }
 
 // Writes a value into Extended ROM in big endian format
-#define WRITE_EXT_8(x,y)    W8BE (ext + ((x) & extMask), (y))
-#define WRITE_EXT_16(x,y)   W16BE(ext + ((x) & extMask), (y))
+#define WRITE_EXT_8(x,y)    { W8BE (ext + ((x) & extMask), (y)); TOUCH_EXT(x); }
+#define WRITE_EXT_16(x,y)   { W16BE(ext + ((x) & extMask), (y)); TOUCH_EXT(x); }
 
 
 class Memory : public SubComponent, public Inspectable<MemInfo, MemStats> {
@@ -211,9 +234,47 @@ public:
     MemorySource cpuMemSrc[256];
     MemorySource agnusMemSrc[256];
 
+    /* Direct-mapped page table for CPU accesses. For each bank, the read table
+     * points to the first byte of the bank if the CPU can read it without any
+     * side effects or bus arbitration (Fast Ram, Rom, Wom, Extended Rom). The
+     * write table is only populated for Fast Ram. All other banks map to
+     * nullptr and are dispatched via cpuMemSrc.
+     * See also: updateCpuPageTable()
+     */
+    u8 *cpuReadPage[256] = { };
+    u8 *cpuWritePage[256] = { };
+
+    // Statistical counters incremented by direct reads
+    isize *cpuReadCounter[256] = { };
+
     // The last value on the data bus
     u16 dataBus;
 
+    /* All memory areas are divided into pages of 4 KB. Whenever a page is
+     * modified, it is stamped with the current epoch. The epoch is incremented
+     * once per frame and whenever a checkpoint is taken. When a memory is
+     * cloned, only those pages are copied that have been modified in either
+     * instance since the previous clone. Other clients (e.g., the memory
+     * debugger) can take checkpoints to find out which pages have changed.
+     */
+    u32 epoch = 1;
+    u32 romStamps[KB(512) >> MEM_PAGE_SHIFT] = { };
+    u32 womStamps[KB(256) >> MEM_PAGE_SHIFT] = { };
+    u32 extStamps[KB(512) >> MEM_PAGE_SHIFT] = { };
+    u32 chipStamps[MB(2) >> MEM_PAGE_SHIFT] = { };
+    u32 slowStamps[KB(1792) >> MEM_PAGE_SHIFT] = { };
+    u32 fastStamps[MB(8) >> MEM_PAGE_SHIFT] = { };
+
+    // The epoch of the source instance at the time of the latest clone
+    u32 syncEpoch = 0;
+
+private:
+
+    // Number of bytes copied by the latest clone
+    isize clonedBytes = 0;
+
+public:
+
     // Static buffer for returning textual representations
     // TODO: Replace by "static string str" and make it local
     char str[256];
@@ -227,29 +288,13 @@ public:
     
     Memory(Amiga& ref);
 
-    Memory& operator= (const Memory& other) {
-
-        CLONE(romAllocator)
-        CLONE(womAllocator)
-        CLONE(extAllocator)
-        CLONE(chipAllocator)
-        CLONE(slowAllocator)
-        CLONE(fastAllocator)
+    Memory& operator= (const Memory& other);
 
-        CLONE(womIsLocked)
-        CLONE_ARRAY(cpuMemSrc)
-        CLONE_ARRAY(agnusMemSrc)
-        CLONE(dataBus)
-
-        CLONE(romMask)
-        CLONE(womMask)
-        CLONE(extMask)
-        CLONE(chipMask)
+private:
 
-        CLONE(config)
-        
-        return *this;
-    }
+    // Copies all pages that have been modified since the latest clone
+    void clone(Allocator<u8> &allocator, u32 *stamps,
+               const Allocator<u8> &other, const u32 *otherStamps);
 
 
     //
@@ -389,6 +434,55 @@ private:
     
     void fillRamWithInitPattern();
 
+public:
+
+    // Stamps all pages of all memory areas with the current epoch
+    void touchAll();
+
+    // Stamps all Chip Ram pages overlapping the specified address range
+    void touchChip(u32 first, u32 last);
+
+    /* Translates an Agnus address into a Chip Ram pointer for direct access.
+     * On entry, 'bytes' is the size of the requested block. On exit, it is
+     * the size of the accessible prefix, which neither wraps around, leaves
+     * the current Chip Ram mirror, nor covers a bank without Chip Ram. If no
+     * byte is accessible, nullptr is returned.
+     */
+    u8 *rawChipPtr(u32 addr, isize &bytes) const;
+
+
+    //
+    // Tracking modifications
+    //
+
+public:
+
+    // Takes a checkpoint (pages modified afterwards have a greater stamp)
+    u32 checkpoint() { return epoch++; }
+
+    // Returns the number of pages of a certain memory type
+    isize numPages(MemorySource src) const;
+
+    // Checks if a page has been modified since a checkpoint
+    bool isModified(MemorySource src, isize page, u32 since) const;
+
+    // Returns a bitmap of all pages that have been modified since a checkpoint
+    std::vector<bool> modifiedPages(MemorySource src, u32 since) const;
+
+    // Returns the number of pages that have been modified since a checkpoint
+    isize countModifiedPages(MemorySource src, u32 since) const;
+
+    // Marks a page as modified
+    void touchPage(MemorySource src, isize page);
+
+    // Returns the number of bytes copied by the latest clone
+    isize getClonedBytes() const { return clonedBytes; }
+
+private:
+
+    // Returns the stamp table for a certain memory type
+    const u32 *getStamps(MemorySource src) const;
+
     
     //
     // Managing ROM
@@ -414,9 +508,9 @@ public:
     bool hasExt() const { return ext != nullptr; }
 
     // Erases an installed Rom
-    void eraseRom() { std::memset(rom, 0, config.romSize); }
-    void eraseWom() { std::memset(wom, 0, config.womSize); }
-    void eraseExt() { std::memset(ext, 0, config.extSize); }
+    void eraseRom() { std::memset(rom, 0, config.romSize); touchAll(); }
+    void eraseWom() { std::memset(wom, 0, config.womSize); touchAll(); }
+    void eraseExt() { std::memset(ext, 0, config.extSize); touchAll(); }
     
     // Installs a Boot Rom or Kickstart Rom
     void loadRom(class MediaFile &file) throws;
@@ -466,6 +560,9 @@ private:
     void updateCpuMemSrcTable();
     void updateAgnusMemSrcTable();
 
+    // Rebuilds the direct-mapped page table from cpuMemSrc
+    void updateCpuPageTable();
+
     // Checks whether Agnus is able to access Slow Ram
     bool slowRamIsMirroredIn() const;
 
@@ -540,13 +637,16 @@ public:
     void patch(u32 addr, u8 value);
     void patch(u32 addr, u16 value);
     void patch(u32 addr, u32 value);
-    void patch(u32 addr, u8 *buf, isize len);
+    void patch(u32 addr, const u8 *buf, isize len);
 
 
     //
     // Perfoming periodic tasks
     //
 
+    // Finishes up the current rasterline
+    void eolHandler();
+
     // Finishes up the current frame
     void eofHandler();
 
@@ -247,6 +247,47 @@ MemoryDebugger::save(std::ostream& os, u32 addr, isize count)
     }
 }
 
+void
+MemoryDebugger::pageDump(std::ostream& os)
+{
+    using namespace util;
+
+    auto dump = [&](const string &name, MemorySource src) {
+
+        auto count = mem.numPages(src);
+        if (count == 0) return;
+
+        auto pages = mem.modifiedPages(src, checkpoint);
+        auto modified = std::count(pages.begin(), pages.end(), true);
+
+        os << tab(name);
+        os << dec(modified) << " of " << dec(count) << " pages modified" << std::endl;
+
+        // List all modified areas as offset ranges
+        for (isize i = 0; i < count; i++) {
+
+            if (!pages[i]) continue;
+
+            isize j = i;
+            while (j + 1 < count && pages[j + 1]) j++;
+
+            os << tab("");
+            os << hex(u32(i * MEM_PAGE_SIZE)) << " - ";
+            os << hex(u32((j + 1) * MEM_PAGE_SIZE - 1)) << std::endl;
+            i = j;
+        }
+    };
+
+    dump("Chip Ram", MEM_CHIP);
+    dump("Slow Ram", MEM_SLOW);
+    dump("Fast Ram", MEM_FAST);
+    dump("Rom", MEM_ROM);
+    dump("Wom", MEM_WOM);
+    dump("Extended Rom", MEM_EXT);
+
+    checkpoint = mem.checkpoint();
+}
+
 void
 MemoryDebugger::save(fs::path& path, u32 addr, isize count)
 {
@@ -33,6 +33,9 @@ public:
     // Last used address (current object location) (TODO: MOVE TO CALLER SIDE?!)
     u32 current = 0;
 
+    // Checkpoint used to detect modified memory pages
+    u32 checkpoint = 0;
+
 
     //
     // Methods
@@ -112,6 +115,9 @@ public:
     void save(std::ostream& is, u32 addr, isize count);
     void save(fs::path& path, u32 addr, isize count);
 
+    // Lists all memory pages that have been modified since the previous call
+    void pageDump(std::ostream& os);
+
 
     //
     // Handling registers
@@ -252,5 +252,8 @@ typedef struct
     struct { isize raw; double accumulated; } fastWrites;
     struct { isize raw; double accumulated; } kickReads;
     struct { isize raw; double accumulated; } kickWrites;
+
+    // Indicates if the values are estimated (write accesses are not recorded)
+    bool sampled;
 }
 MemStats;
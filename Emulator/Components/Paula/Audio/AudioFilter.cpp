@@ -65,6 +65,36 @@ OnePoleFilter::applyHP(double &l, double &r)
     r = r - tmpR;
 }
 
+void
+OnePoleFilter::applyLP(double *l, double *r, isize n)
+{
+    // Keep the filter state in registers while processing the block
+    auto apply = [n, a1 = a1, a2 = a2](double *x, double &tmp) {
+
+        auto t = tmp;
+        for (isize i = 0; i < n; i++) { t = (a1 * x[i]) + (a2 * t); x[i] = t; }
+        tmp = t;
+    };
+
+    apply(l, tmpL);
+    apply(r, tmpR);
+}
+
+void
+OnePoleFilter::applyHP(double *l, double *r, isize n)
+{
+    // Keep the filter state in registers while processing the block
+    auto apply = [n, a1 = a1, a2 = a2](double *x, double &tmp) {
+
+        auto t = tmp;
+        for (isize i = 0; i < n; i++) { t = (a1 * x[i]) + (a2 * t); x[i] = x[i] - t; }
+        tmp = t;
+    };
+
+    apply(l, tmpL);
+    apply(r, tmpR);
+}
+
 
 //
 // TwoPoleFilter
@@ -123,6 +153,32 @@ TwoPoleFilter::applyLP(double &l, double &r)
     tmpR[2] = r;
 }
 
+void
+TwoPoleFilter::applyLP(double *l, double *r, isize n)
+{
+    // Keep the filter state in registers while processing the block
+    auto apply = [n, a1 = a1, a2 = a2, b1 = b1, b2 = b2](double *x, double *tmp) {
+
+        auto t0 = tmp[0], t1 = tmp[1], t2 = tmp[2], t3 = tmp[3];
+
+        for (isize i = 0; i < n; i++) {
+
+            auto in = x[i];
+            auto out = (a1 * in) + (a2 * t0) + (a1 * t1) - (b1 * t2) - (b2 * t3);
+
+            t1 = t0;
+            t0 = in;
+            t3 = t2;
+            t2 = out;
+            x[i] = out;
+        }
+
+        tmp[0] = t0; tmp[1] = t1; tmp[2] = t2; tmp[3] = t3;
+    };
+
+    apply(l, tmpL);
+    apply(r, tmpR);
+}
 
 //
 // AudioFilter (Filter pipeline)
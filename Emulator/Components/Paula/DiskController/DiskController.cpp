@@ -520,20 +520,52 @@ DiskController::performTurboDMA(FloppyDrive *drive)
 void
 DiskController::performTurboRead(FloppyDrive *drive)
 {
-    for (isize i = 0; i < (dsklen & 0x3FFF); i++) {
-        
-        // Read word from disk
-        u16 word = drive->readWordAndRotate();
-        
-        // Write word into memory
-        if (DSK_CHECKSUM) {
-            
-            checkcnt++;
-            check1 = util::fnvIt32(check1, word);
-            check2 = util::fnvIt32(check2, agnus.dskpt & agnus.ptrMask);
+    isize remaining = dsklen & 0x3FFF;
+
+    while (remaining) {
+
+        u32 addr = agnus.dskpt & agnus.ptrMask;
+
+        // Blocks must start at a word boundary
+        isize bytes = 2 * remaining;
+        u8 *p = (addr & 1) ? nullptr : mem.rawChipPtr(addr, bytes);
+        isize words = p ? bytes / 2 : 0;
+
+        if (words) {
+
+            // Read a contiguous block from disk straight into Chip Ram
+            drive->readBlockAndRotate(p, 2 * words);
+            mem.touchChip(addr, addr + u32(2 * words) - 1);
+            mem.dataBus = R16BE(p + 2 * words - 2);
+
+            if (DSK_CHECKSUM) {
+
+                for (isize i = 0; i < words; i++) {
+
+                    checkcnt++;
+                    check1 = util::fnvIt32(check1, R16BE(p + 2 * i));
+                    check2 = util::fnvIt32(check2, addr + u32(2 * i));
+                }
+            }
+
+        } else {
+
+            // Read word from disk
+            u16 word = drive->readWordAndRotate();
+
+            // Write word into memory
+            if (DSK_CHECKSUM) {
+
+                checkcnt++;
+                check1 = util::fnvIt32(check1, word);
+                check2 = util::fnvIt32(check2, addr);
+            }
+            mem.poke16 <ACCESSOR_AGNUS> (agnus.dskpt, word);
+            words = 1;
         }
-        mem.poke16 <ACCESSOR_AGNUS> (agnus.dskpt, word);
-        agnus.dskpt += 2;
+
+        agnus.dskpt += u32(2 * words);
+        remaining -= words;
     }
     
     debug(DSK_CHECKSUM, "Turbo read %s: cyl: %ld side: %ld offset: %ld ",
@@ -549,22 +581,52 @@ DiskController::performTurboRead(FloppyDrive *drive)
 void
 DiskController::performTurboWrite(FloppyDrive *drive)
 {
-    for (isize i = 0; i < (dsklen & 0x3FFF); i++) {
-        
-        // Read word from memory
-        u16 word = mem.peek16 <ACCESSOR_AGNUS> (agnus.dskpt);
-        
-        if (DSK_CHECKSUM) {
-            
-            checkcnt++;
-            check1 = util::fnvIt32(check1, word);
-            check2 = util::fnvIt32(check2, agnus.dskpt & agnus.ptrMask);
+    isize remaining = dsklen & 0x3FFF;
+
+    while (remaining) {
+
+        u32 addr = agnus.dskpt & agnus.ptrMask;
+
+        // Blocks must start at a word boundary
+        isize bytes = 2 * remaining;
+        u8 *p = (addr & 1) ? nullptr : mem.rawChipPtr(addr, bytes);
+        isize words = p ? bytes / 2 : 0;
+
+        if (words) {
+
+            // Write a contiguous block from Chip Ram straight onto the disk
+            drive->writeBlockAndRotate(p, 2 * words);
+            mem.dataBus = R16BE(p + 2 * words - 2);
+
+            if (DSK_CHECKSUM) {
+
+                for (isize i = 0; i < words; i++) {
+
+                    checkcnt++;
+                    check1 = util::fnvIt32(check1, R16BE(p + 2 * i));
+                    check2 = util::fnvIt32(check2, addr + u32(2 * i));
+                }
+            }
+
+        } else {
+
+            // Read word from memory
+            u16 word = mem.peek16 <ACCESSOR_AGNUS> (agnus.dskpt);
+
+            if (DSK_CHECKSUM) {
+
+                checkcnt++;
+                check1 = util::fnvIt32(check1, word);
+                check2 = util::fnvIt32(check2, addr);
+            }
+
+            // Write word to disk
+            drive->writeWordAndRotate(word);
+            words = 1;
         }
-        
-        agnus.dskpt += 2;
-        
-        // Write word to disk
-        drive->writeWordAndRotate(word);
+
+        agnus.dskpt += u32(2 * words);
+        remaining -= words;
     }
     
     debug(DSK_CHECKSUM,
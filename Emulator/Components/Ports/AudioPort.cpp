@@ -381,10 +381,22 @@ AudioPort::synthesize(Cycle clock, long count, double cyclesPerSample)
 {
     assert(count > 0);
 
-    float vol0 = vol[0]; float pan0 = pan[0];
-    float vol1 = vol[1]; float pan1 = pan[1];
-    float vol2 = vol[2]; float pan2 = pan[2];
-    float vol3 = vol[3]; float pan3 = pan[3];
+    /* Samples are processed in blocks. For each block, all four channels are
+     * interpolated first. Afterwards, the channels are mixed, filtered, and
+     * scaled by the master volume in tight loops which the compiler is able to
+     * vectorize. Finally, the block is committed to the ring buffer at once.
+     */
+    constexpr isize blockSize = 256;
+
+    float ch[4][blockSize];
+    double l[blockSize];
+    double r[blockSize];
+    SamplePair out[blockSize];
+
+    float pan0 = pan[0];
+    float pan1 = pan[1];
+    float pan2 = pan[2];
+    float pan3 = pan[3];
     bool fading = volL.isFading() || volR.isFading();
 
     double cycle = (double)clock;
@@ -392,37 +404,65 @@ AudioPort::synthesize(Cycle clock, long count, double cyclesPerSample)
     bool ledEnabled = filter.ledFilterEnabled();
     bool hiEnabled = filter.hiFilterEnabled();
 
-    for (isize i = 0; i < count; i++) {
+    for (isize done = 0; done < count; done += blockSize) {
 
-        float ch0 = sampler[0].interpolate <method> ((Cycle)cycle) * vol0;
-        float ch1 = sampler[1].interpolate <method> ((Cycle)cycle) * vol1;
-        float ch2 = sampler[2].interpolate <method> ((Cycle)cycle) * vol2;
-        float ch3 = sampler[3].interpolate <method> ((Cycle)cycle) * vol3;
+        isize n = std::min(isize(count - done), blockSize);
+
+        // Interpolate all four channels
+        double next = cycle;
+        for (isize c = 0; c < 4; c++) {
+
+            auto v = vol[c];
+            next = cycle;
+
+            for (isize i = 0; i < n; i++) {
+
+                ch[c][i] = sampler[c].interpolate <method> ((Cycle)next) * v;
+                next += cyclesPerSample;
+            }
+        }
+        cycle = next;
 
         // Compute left and right channel output
-        double l = ch0 * (1 - pan0) + ch1 * (1 - pan1) + ch2 * (1 - pan2) + ch3 * (1 - pan3);
-        double r = ch0 * pan0 + ch1 * pan1 + ch2 * pan2 + ch3 * pan3;
+        for (isize i = 0; i < n; i++) {
 
-        // Run the audio filter pipeline
-        if (loEnabled) filter.loFilter.applyLP(l, r);
-        if (ledEnabled) filter.ledFilter.applyLP(l, r);
-        if (hiEnabled) filter.hiFilter.applyHP(l, r);
+            l[i] = ch[0][i] * (1 - pan0) + ch[1][i] * (1 - pan1) + ch[2][i] * (1 - pan2) + ch[3][i] * (1 - pan3);
+            r[i] = ch[0][i] * pan0 + ch[1][i] * pan1 + ch[2][i] * pan2 + ch[3][i] * pan3;
+        }
 
-        // Modulate the master volume
-        if (fading) { volL.shift(); volR.shift(); }
+        // Run the audio filter pipeline
+        if (loEnabled) filter.loFilter.applyLP(l, r, n);
+        if (ledEnabled) filter.ledFilter.applyLP(l, r, n);
+        if (hiEnabled) filter.hiFilter.applyHP(l, r, n);
 
         // Apply master volume
-        l *= volL;
-        r *= volR;
+        if (fading) {
 
-        // Prevent hearing loss
-        assert(std::abs(l) < 1.0);
-        assert(std::abs(r) < 1.0);
+            // Modulate the master volume
+            for (isize i = 0; i < n; i++) {
 
-        // Write sample into ringbuffer
-        stream.write( SamplePair { float(l), float(r) } );
+                volL.shift(); volR.shift();
+                l[i] *= volL;
+                r[i] *= volR;
+            }
+
+        } else {
+
+            double vl = volL, vr = volR;
+            for (isize i = 0; i < n; i++) { l[i] *= vl; r[i] *= vr; }
+        }
+
+        for (isize i = 0; i < n; i++) {
+
+            // Prevent hearing loss
+            assert(std::abs(l[i]) < 1.0);
+            assert(std::abs(r[i]) < 1.0);
+
+            out[i] = SamplePair { float(l[i]), float(r[i]) };
+        }
 
-        cycle += cyclesPerSample;
+        // Write samples into ringbuffer
+        stream.write(out, n);
     }
 
     stats.producedSamples += count;
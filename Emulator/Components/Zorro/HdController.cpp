@@ -144,7 +144,7 @@ HdController::setOption(Option option, i64 value)
 bool
 HdController::pluggedIn() const
 {
-    return drive.isConnected() && !drive.data.empty();
+    return drive.isConnected() && drive.hasDisk();
 }
 
 void
@@ -12,8 +12,11 @@
 #include "Amiga.h"
 #include "Script.h"
 #include "DiagRom.h"
+#include "Checksum.h"
+#include "Parser.h"
 #include <filesystem>
 #include <chrono>
+#include <thread>
 
 int main(int argc, char *argv[])
 {
@@ -24,12 +27,16 @@ int main(int argc, char *argv[])
     } catch (vamiga::SyntaxError &e) {
         
         std::cout << "Usage: vAmigaCore [-fsdvm] [<script>]" << std::endl;
+        std::cout << "       vAmigaCore -b [-j <jobs>] [-r <report>] <manifest>" << std::endl;
         std::cout << std::endl;
         std::cout << "       -f or --footprint   Reports the size of certain objects" << std::endl;
         std::cout << "       -s or --smoke       Runs some smoke tests to test the build" << std::endl;
         std::cout << "       -d or --diagnose    Run DiagRom in the background" << std::endl;
         std::cout << "       -v or --verbose     Print executed script lines" << std::endl;
         std::cout << "       -m or --messages    Observe the message queue" << std::endl;
+        std::cout << "       -b or --batch       Run all jobs listed in a manifest file" << std::endl;
+        std::cout << "       -j or --jobs        Number of worker threads in batch mode" << std::endl;
+        std::cout << "       -r or --report      Report file written in batch mode" << std::endl;
         std::cout << "       <script>            Execute this script instead of the default" << std::endl;
         std::cout << std::endl;
         
@@ -69,6 +76,7 @@ Headless::main(int argc, char *argv[])
     parseArguments(argc, argv);
 
     // Check options
+    if (keys.find("batch") != keys.end())       { return runBatch(keys["arg1"]); }
     if (keys.find("footprint") != keys.end())   { reportSize(); }
     if (keys.find("smoke") != keys.end())       { runScript(smokeTestScript); }
     if (keys.find("diagnose") != keys.end())    { runScript(selfTestScript); }
@@ -88,6 +96,12 @@ Headless::parseArguments(int argc, char *argv[])
 
         auto arg = string(argv[i]);
 
+        // Returns the value of an option that expects an argument
+        auto value = [&]() {
+            if (++i == argc) throw SyntaxError("Missing value for option '" + arg + "'");
+            return string(argv[i]);
+        };
+
         if (arg[0] == '-') {
 
             if (arg == "-f" || arg == "--footprint") { keys["footprint"] = "1"; continue; }
@@ -95,6 +109,11 @@ Headless::parseArguments(int argc, char *argv[])
             if (arg == "-d" || arg == "--diagnose")  { keys["diagnose"] = "1"; continue; }
             if (arg == "-v" || arg == "--verbose")   { keys["verbose"] = "1"; continue; }
             if (arg == "-m" || arg == "--messages")  { keys["messages"] = "1"; continue; }
+            if (arg == "-b" || arg == "--batch")     { keys["batch"] = "1"; continue; }
+            if (arg == "-j" || arg == "--jobs")      { keys["jobs"] = value(); continue; }
+            if (arg == "-r" || arg == "--report")    {
+                keys["report"] = std::filesystem::absolute(value()).string(); continue;
+            }
 
             throw SyntaxError("Invalid option '" + arg + "'");
         }
@@ -119,6 +138,19 @@ Headless::checkArguments()
     if (keys.find("arg1") != keys.end() && !util::fileExists(keys["arg1"])) {
         throw SyntaxError("File " + keys["arg1"] + " does not exist");
     }
+
+    // Batch mode requires a manifest
+    if (keys.find("batch") != keys.end() && keys.find("arg1") == keys.end()) {
+        throw SyntaxError("No manifest file is given");
+    }
+
+    // The number of worker threads must be positive
+    if (keys.find("jobs") != keys.end()) {
+
+        long jobs = 0;
+        try { jobs = util::parseNum(keys["jobs"]); } catch (util::ParseError &) { }
+        if (jobs <= 0) throw SyntaxError("Invalid number of jobs: " + keys["jobs"]);
+    }
 }
 
 int
@@ -159,6 +191,365 @@ Headless::runScript(const std::filesystem::path &path)
     return *returnCode;
 }
 
+int
+Headless::runBatch(const std::filesystem::path &path)
+{
+    auto jobs = parseManifest(path);
+    auto results = std::vector<BatchResult>(jobs.size());
+    auto count = isize(jobs.size());
+
+    // Determine the number of worker threads
+    isize workers = std::thread::hardware_concurrency();
+    if (keys.find("jobs") != keys.end()) workers = util::parseNum(keys["jobs"]);
+    workers = std::max(isize(1), std::min(workers, count));
+
+    std::cout << "Running " << count << " jobs on " << workers << " threads" << std::endl;
+
+    std::atomic<isize> next = 0;
+    std::mutex coutMutex;
+    isize completed = 0;
+    auto start = util::Time::now();
+
+    // Each worker picks up the next pending job until all jobs are done
+    auto worker = [&]() {
+
+        for (isize i = next++; i < count; i = next++) {
+
+            results[i] = BatchWorker(jobs[i]).run();
+
+            std::lock_guard<std::mutex> lock(coutMutex);
+            auto &r = results[i];
+
+            std::cout << "[" << ++completed << "/" << count << "] ";
+            std::cout << path.filename().string() << ":" << jobs[i].line << ": " << r.status;
+            if (r.status == "error") {
+                std::cout << " (" << r.error << ")";
+            } else {
+                std::cout << " (exit code " << r.exitCode << ", " << r.frames << " frames, ";
+                std::cout << std::fixed << std::setprecision(2) << r.wallTime << " sec)";
+            }
+            std::cout << std::endl;
+        }
+    };
+
+    std::vector<std::thread> pool;
+    for (isize i = 0; i < workers; i++) pool.emplace_back(worker);
+    for (auto &thread : pool) thread.join();
+
+    // Write the report
+    auto report = keys.find("report") != keys.end() ?
+    std::filesystem::path(keys["report"]) :
+    path.parent_path() / (path.stem().string() + "-report.json");
+
+    auto file = std::ofstream(report);
+    if (!file.is_open()) throw Error(ERROR_FILE_CANT_CREATE, report.string());
+    writeReport(file, jobs, results);
+
+    // Summarize
+    isize passed = 0;
+    for (auto &r : results) if (r.status == "finished" && r.exitCode == 0) passed++;
+
+    std::cout << passed << " of " << count << " jobs passed in ";
+    std::cout << std::fixed << std::setprecision(2) << (util::Time::now() - start).asSeconds();
+    std::cout << " sec. Report written to " << report.string() << std::endl;
+
+    return passed == count ? 0 : 1;
+}
+
+std::vector<BatchJob>
+Headless::parseManifest(const std::filesystem::path &path)
+{
+    /* A manifest lists one job per line. Each job is described by five
+     * whitespace-separated fields:
+     *
+     *     <config scheme> <rom> <disk> <script> <frames>
+     *
+     * Relative paths are resolved against the manifest's directory. A dash
+     * indicates an omitted file. If no Rom is given, DiagRom is used. Text
+     * following a '#' character is ignored.
+     */
+    auto stream = std::ifstream(path);
+    if (!stream.is_open()) throw Error(ERROR_FILE_NOT_FOUND, path.string());
+
+    std::vector<BatchJob> result;
+    string line;
+
+    for (isize nr = 1; std::getline(stream, line); nr++) {
+
+        auto where = path.filename().string() + ":" + std::to_string(nr) + ": ";
+
+        // Strip off comments
+        if (auto pos = line.find('#'); pos != string::npos) line.erase(pos);
+
+        // Split the line into tokens
+        std::vector<string> tokens;
+        std::istringstream ss(line);
+        for (string token; ss >> token; ) tokens.push_back(token);
+
+        // Skip empty lines
+        if (tokens.empty()) continue;
+
+        if (tokens.size() != 5) {
+            throw SyntaxError(where + "Expected 5 fields, found " + std::to_string(tokens.size()));
+        }
+
+        BatchJob job;
+        job.line = nr;
+
+        try {
+
+            job.scheme = util::parseEnum<ConfigScheme, ConfigSchemeEnum>(tokens[0]);
+            job.frames = util::parseNum(tokens[4]);
+
+        } catch (util::ParseError &e) {
+
+            throw SyntaxError(where + "Invalid field '" + e.token + "'");
+        }
+
+        if (job.frames <= 0) {
+            throw SyntaxError(where + "The frame budget must be positive");
+        }
+
+        auto resolve = [&](const string &token) {
+
+            if (token == "-") return std::filesystem::path();
+
+            auto file = std::filesystem::path(token);
+            if (file.is_relative()) file = path.parent_path() / file;
+            if (!util::fileExists(file)) throw SyntaxError(where + "File " + file.string() + " does not exist");
+            return file;
+        };
+
+        job.rom = resolve(tokens[1]);
+        job.disk = resolve(tokens[2]);
+        job.script = resolve(tokens[3]);
+
+        result.push_back(job);
+    }
+
+    return result;
+}
+
+void
+Headless::writeReport(std::ostream &os,
+                      const std::vector<BatchJob> &jobs,
+                      const std::vector<BatchResult> &results)
+{
+    auto quote = [](const string &s) {
+
+        string result = "\"";
+        for (auto c : s) {
+            if (c == '"' || c == '\\') result += '\\';
+            result += c;
+        }
+        return result + "\"";
+    };
+
+    os << "{" << std::endl;
+    os << "  \"version\": " << quote(VAmiga::version()) << "," << std::endl;
+    os << "  \"jobs\": [" << std::endl;
+
+    for (usize i = 0; i < jobs.size(); i++) {
+
+        auto &job = jobs[i];
+        auto &r = results[i];
+
+        os << "    {" << std::endl;
+        os << "      \"line\": " << job.line << "," << std::endl;
+        os << "      \"scheme\": " << quote(ConfigSchemeEnum::key(job.scheme)) << "," << std::endl;
+        os << "      \"rom\": " << quote(job.rom.string()) << "," << std::endl;
+        os << "      \"disk\": " << quote(job.disk.string()) << "," << std::endl;
+        os << "      \"script\": " << quote(job.script.string()) << "," << std::endl;
+        os << "      \"status\": " << quote(r.status) << "," << std::endl;
+        os << "      \"error\": " << quote(r.error) << "," << std::endl;
+        os << "      \"exitCode\": " << r.exitCode << "," << std::endl;
+        os << "      \"frames\": " << r.frames << "," << std::endl;
+        os << "      \"checksum\": \"" << std::hex << std::setw(16) << std::setfill('0');
+        os << r.checksum << std::dec << std::setfill(' ') << "\"," << std::endl;
+        os << "      \"wallTime\": " << std::fixed << std::setprecision(3) << r.wallTime << std::endl;
+        os << "    }" << (i + 1 < jobs.size() ? "," : "") << std::endl;
+    }
+
+    os << "  ]" << std::endl;
+    os << "}" << std::endl;
+}
+
+BatchResult
+BatchWorker::run()
+{
+    auto start = util::Time::now();
+
+    try {
+
+        // Create an emulator instance
+        VAmiga emu;
+        vamiga = &emu;
+
+        // Launch the emulator thread
+        emu.launch(this, [](const void *listener, Message msg) {
+            ((BatchWorker *)listener)->process(msg);
+        });
+
+        // Configure the machine
+        emu.set(job.scheme);
+
+        if (job.rom.empty()) {
+            emu.mem.loadRom(diagROM13, sizeofDiagRom13);
+        } else {
+            emu.mem.loadRom(job.rom);
+        }
+
+        if (!job.disk.empty()) {
+
+            std::unique_ptr<MediaFile> adf(MediaFile::make(job.disk));
+            emu.df0.insertMedia(*adf, false);
+        }
+
+        // Run as fast as possible (use a source the shell can't switch off)
+        emu.warpOn(1);
+        emu.powerOn();
+
+        /* The frame budget is checked by the emulator thread. Once per frame,
+         * an alarm notifies the worker which stops the emulator when the
+         * budget is exhausted. Hence, a timeout always happens at the same
+         * cycle, no matter how fast the host machine is.
+         */
+        {   std::lock_guard<std::mutex> lock(mutex);
+            scheduleTimeout();
+        }
+        emu.run();
+
+        // Execute the script
+        if (!job.script.empty()) emu.retroShell.execScript(Script(job.script));
+
+        /* Wait until the job terminates or the frame budget is exhausted. The
+         * wall-clock limit catches scripts that pause or halt the emulator in
+         * which case the frame budget is never checked again.
+         */
+        const auto deadline = start + util::Time::seconds(500.0);
+
+        while (true) {
+
+            waitForWakeUp(util::Time::milliseconds(100));
+
+            {   std::lock_guard<std::mutex> lock(mutex);
+                if (finished) break;
+            }
+
+            if (util::Time::now() > deadline) {
+
+                // Pause first (the emulator thread might wait for the mutex)
+                emu.pause();
+
+                std::lock_guard<std::mutex> lock(mutex);
+                if (!finished) {
+
+                    grabTexture();
+                    result.status = "timeout";
+                    result.error = "Wall-clock limit exceeded";
+                    finished = true;
+                }
+                break;
+            }
+        }
+
+    } catch (Error &e) {
+
+        result.status = "error";
+        result.error = e.what();
+
+    } catch (std::exception &e) {
+
+        result.status = "error";
+        result.error = e.what();
+    }
+
+    vamiga = nullptr;
+    result.wallTime = (util::Time::now() - start).asSeconds();
+    return result;
+}
+
+void
+BatchWorker::process(Message msg)
+{
+    switch (msg.type) {
+
+        case MSG_RSH_ERROR:
+        case MSG_ABORT:
+
+            {   std::lock_guard<std::mutex> lock(mutex);
+
+                if (finished || !vamiga) break;
+
+                // Grab the texture right away to get a deterministic checksum
+                grabTexture();
+                if (msg.type == MSG_ABORT) {
+
+                    result.status = "finished";
+                    result.exitCode = msg.value;
+
+                } else {
+
+                    result.status = "error";
+                    result.error = "Script error";
+                }
+                finished = true;
+            }
+            wakeUp();
+            break;
+
+        case MSG_ALARM:
+
+            {   std::lock_guard<std::mutex> lock(mutex);
+
+                if (finished || !vamiga) break;
+
+                auto &amiga = *vamiga->amiga.amiga;
+
+                // Keep running if the frame budget isn't exhausted yet
+                if (amiga.agnus.pos.frame < job.frames) {
+
+                    scheduleTimeout();
+                    break;
+                }
+
+                grabTexture();
+                result.status = "timeout";
+                finished = true;
+
+                // Stop the emulator after the current instruction
+                amiga.setFlag(RL::STOP);
+            }
+            wakeUp();
+            break;
+
+        default:
+            break;
+    }
+}
+
+void
+BatchWorker::scheduleTimeout()
+{
+    auto &amiga = *vamiga->amiga.amiga;
+    auto &pos = amiga.agnus.pos;
+
+    // Wake up at the beginning of the next frame
+    auto cycles = pos.diff(0, 0);
+    if (cycles <= 0) cycles = pos.cyclesPerFrame();
+
+    amiga.setAlarmRel(DMA_CYCLES(cycles), job.line);
+}
+
+void
+BatchWorker::grabTexture()
+{
+    auto &amiga = *vamiga->amiga.amiga;
+
+    result.frames = amiga.agnus.pos.frame;
+    result.checksum = amiga.regressionTester.computeChecksum(amiga);
+}
+
 void
 process(const void *listener, Message msg)
 {
@@ -13,6 +13,7 @@
 #include "Wakeable.h"
 #include "HeadlessScripts.h"
 #include <map>
+#include <mutex>
 
 namespace vamiga {
 
@@ -23,6 +24,81 @@ struct SyntaxError : public std::runtime_error {
 // The message listener
 void process(const void *listener, Message msg);
 
+// A single line of a batch manifest
+struct BatchJob {
+
+    // Line number inside the manifest
+    isize line = 0;
+
+    // Machine configuration
+    ConfigScheme scheme = CONFIG_A500_OCS_1MB;
+
+    // Media files (empty if not specified)
+    std::filesystem::path rom;
+    std::filesystem::path disk;
+    std::filesystem::path script;
+
+    // Maximum number of frames to emulate
+    i64 frames = 0;
+};
+
+// The outcome of a batch job
+struct BatchResult {
+
+    // "finished", "timeout", or "error"
+    string status = "error";
+
+    // Value passed to MSG_ABORT
+    i64 exitCode = -1;
+
+    // Number of emulated frames
+    i64 frames = 0;
+
+    // Checksum of the regression test image
+    u64 checksum = 0;
+
+    // Elapsed real time in seconds
+    double wallTime = 0.0;
+
+    // Error description (if any)
+    string error;
+};
+
+// Runs a single batch job inside a dedicated emulator instance
+class BatchWorker : Wakeable {
+
+    // The job to run
+    const BatchJob &job;
+
+    // The job's outcome
+    BatchResult result;
+
+    // Emulator instance (only valid while the job is running)
+    VAmiga *vamiga = nullptr;
+
+    // Indicates whether the result is final (protected by the mutex)
+    bool finished = false;
+    std::mutex mutex;
+
+public:
+
+    BatchWorker(const BatchJob &job) : job(job) { }
+
+    // Runs the job to completion
+    BatchResult run();
+
+    // Processes an incoming message (called on the emulator thread)
+    void process(Message msg);
+
+private:
+
+    // Schedules an alarm for the next frame (called on the emulator thread)
+    void scheduleTimeout();
+
+    // Records the frame count and the checksum of the current texture
+    void grabTexture();
+};
+
 class Headless : Wakeable {
 
     // Parsed command line arguments
@@ -53,6 +129,17 @@ private:
     int runScript(const char **script);
     int runScript(const std::filesystem::path &path);
 
+    // Runs all jobs of a batch manifest
+    int runBatch(const std::filesystem::path &path);
+
+    // Parses a batch manifest
+    std::vector<BatchJob> parseManifest(const std::filesystem::path &path) throws;
+
+    // Writes the results of a batch run
+    void writeReport(std::ostream &os,
+                     const std::vector<BatchJob> &jobs,
+                     const std::vector<BatchResult> &results);
+
     
     //
     // Running
@@ -312,11 +312,8 @@ ADFFile::encodeDisk(FloppyDisk &disk) const
     isize tracks = numTracks();
     debug(ADF_DEBUG, "Encoding Amiga disk with %ld tracks\n", tracks);
 
-    // Start with an unformatted disk
-    disk.clearDisk();
-
-    // Encode all tracks
-    for (Track t = 0; t < tracks; t++) encodeTrack(disk, t);
+    // Encode all tracks on demand
+    disk.encodeLazily(std::make_shared<ADFFile>(data.ptr, data.size), tracks);
 
     // In debug mode, also run the decoder
     if (ADF_DEBUG) {
@@ -379,8 +376,8 @@ ADFFile::encodeSector(FloppyDisk &disk, Track t, Sector s) const
     // Determine the start of this sector
     u8 *p = disk.data.track[t] + (s * 1088);
 
-    // Bytes before SYNC
-    p[0] = (p[-1] & 1) ? 0x2A : 0xAA;
+    // Bytes before SYNC (the first sector is preceded by the track gap)
+    p[0] = (s > 0 && (p[-1] & 1)) ? 0x2A : 0xAA;
     p[1] = 0xAA;
     p[2] = 0xAA;
     p[3] = 0xAA;
@@ -426,9 +423,7 @@ ADFFile::encodeSector(FloppyDisk &disk, Track t, Sector s) const
     FloppyDisk::encodeOddEven(&p[56], dcheck, sizeof(bcheck));
     
     // Add clock bits
-    for(isize i = 8; i < 1088; i++) {
-        p[i] = FloppyDisk::addClockBits(p[i], p[i-1]);
-    }
+    FloppyDisk::addClockBits(&p[8], 1080);
 }
 
 void
@@ -474,6 +469,11 @@ ADFFile::decodeTrack(FloppyDisk &disk, Track t)
     
     while (index < isizeof(disk.data.track[t]) && nr < sectors) {
 
+        // Skip ahead to the next candidate
+        auto next = (u8 *)memchr(src + index, 0x44, sizeof(disk.data.track[t]) - index);
+        if (!next) break;
+        index = next - src;
+
         // Scan MFM stream for $4489 $4489
         if (src[index++] != 0x44) continue;
         if (src[index++] != 0x89) continue;
@@ -106,10 +106,10 @@ public:
 
     void encodeDisk(class FloppyDisk &disk) const throws override;
     void decodeDisk(class FloppyDisk &disk) throws override;
+    void encodeTrack(class FloppyDisk &disk, Track t) const throws override;
 
 private:
     
-    void encodeTrack(class FloppyDisk &disk, Track t) const throws;
     void encodeSector(class FloppyDisk &disk, Track t, Sector s) const throws;
 
     void decodeTrack(class FloppyDisk &disk, Track t) throws;
@@ -222,6 +222,9 @@ EADFFile::encodeExtendedTrack(class FloppyDisk &disk, Track t) const
         auto numBits = usedBitsForTrack(t);
         assert(numBits % 8 == 0);
 
+        // Let the standard encoder finish this track first
+        disk.encode(t);
+
         std::memcpy(disk.data.track[t], trackData(t), size_t(numBits / 8));
         disk.length.track[t] = i32(numBits / 8);
     }
@@ -232,6 +235,9 @@ EADFFile::decodeDisk(FloppyDisk &disk)
 {
     assert(!data.empty());
     
+    // Make sure that all tracks are MFM encoded
+    disk.encodePendingTracks();
+
     u8 *p = data.ptr;
     auto numTracks = disk.numTracks();
     
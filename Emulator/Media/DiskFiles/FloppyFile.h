@@ -74,6 +74,9 @@ public:
 
     virtual void encodeDisk(FloppyDisk &disk) const throws { fatalError; }
     virtual void decodeDisk(FloppyDisk &disk) throws { fatalError; }
+
+    // Encodes a single track (used by disks that encode tracks on demand)
+    virtual void encodeTrack(FloppyDisk &disk, Track t) const throws { fatalError; }
 };
 
 }
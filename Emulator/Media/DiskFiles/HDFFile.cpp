@@ -67,10 +67,26 @@ HDFFile::init(const u8 *buf, isize len)
     AmigaFile::init(buf, len);
 }
 
+void
+HDFFile::initView(const u8 *buf, isize len)
+{
+    assert(buf);
+
+    // Check size
+    if (isOversized(len)) throw Error(ERROR_HDR_TOO_LARGE);
+
+    image = buf;
+    imageSize = len;
+    finalizeRead();
+}
+
 void
 HDFFile::init(const HardDrive &drive)
 {
-    AmigaFile::readFromBuffer(drive.data);
+    // Merge the memory-mapped image with all modified blocks (if any)
+    data.alloc(drive.geometry.numBytes());
+    drive.copy(data.ptr, 0, data.size);
+    finalizeRead();
     
     // Overwrite the predicted geometry with the precise one
     geometry = drive.getGeometry();
@@ -238,7 +254,7 @@ HDFFile::getFileSystemDescriptor(isize nr) const
 
     // Determine block bounds
     auto first = part.lowCyl * h * s;
-    auto dptr = data.ptr + first * 512;
+    auto dptr = rawPtr() + first * 512;
 
     // Set the number of reserved blocks
     result.numReserved = 2;
@@ -297,9 +313,9 @@ bool
 HDFFile::hasRDB() const
 {
     // The rigid disk block must be among the first 16 blocks
-    if (data.size >= 16 * 512) {
+    if (rawSize() >= 16 * 512) {
         for (isize i = 0; i < 16; i++) {
-            if (strcmp((const char *)data.ptr + i * 512, "RDSK") == 0) return true;
+            if (strcmp((const char *)rawPtr() + i * 512, "RDSK") == 0) return true;
         }
     }
     return false;
@@ -322,7 +338,7 @@ HDFFile::partitionOffset(isize nr) const
 u8 *
 HDFFile::partitionData(isize nr) const
 {
-    return data.ptr + partitionOffset(nr);
+    return rawPtr() + partitionOffset(nr);
 }
 
 isize
@@ -338,28 +354,28 @@ HDFFile::predictNumBlocks() const
     if (auto root = seekRB(); root) {
 
         // Predict block count by analyzing the file size
-        highKey = data.size / bsize() - 1;
+        highKey = rawSize() / bsize() - 1;
         if (match()) return highKey + 1;
         
         // Predict block count by assuming a 32 sector standard geometry
-        highKey = 32 * (data.size / (32 * bsize())) - 1;
+        highKey = 32 * (rawSize() / (32 * bsize())) - 1;
         if (match()) return highKey + 1;
 
         // Predict by faking the numbers to fit
-        highKey = 2 * isize(root - data.ptr) / bsize() - numReserved;
+        highKey = 2 * isize(root - rawPtr()) / bsize() - numReserved;
         if (match()) return highKey + 1;
 
         fatalError;
     }
     
     // No root
-    return data.size / bsize();
+    return rawSize() / bsize();
 }
 
 u8 *
 HDFFile::seekBlock(isize nr) const
 {
-    return nr >= 0 && 512 * (nr + 1) <= data.size ? data.ptr + (512 * nr) : nullptr;
+    return nr >= 0 && 512 * (nr + 1) <= rawSize() ? rawPtr() + (512 * nr) : nullptr;
 }
 
 bool
@@ -371,10 +387,10 @@ HDFFile::isRB(u8 *ptr) const
 u8 *
 HDFFile::seekRB() const
 {
-    auto max = data.size - 512;
+    auto max = rawSize() - 512;
     
     for (isize i = 0; i <= max; i += 512) {
-        if (isRB(data.ptr + i)) return data.ptr + i;
+        if (isRB(rawPtr() + i)) return rawPtr() + i;
     }
 
     return nullptr;
@@ -31,6 +31,17 @@ public:
     // Included device drivers
     std::vector <DriverDescriptor> drivers;
 
+private:
+
+    /* Externally owned disk image. If set, all information is extracted from
+     * this memory area instead of the file data. It is used by hard drives to
+     * analyze memory-mapped HDFs without loading them.
+     */
+    const u8 *image = nullptr;
+    isize imageSize = 0;
+
+public:
+
     static bool isCompatible(const std::filesystem::path &path);
     static bool isCompatible(std::istream &stream);
     static bool isOversized(isize size) { return size > MB(504); }
@@ -48,6 +59,7 @@ public:
 public:
     
     HDFFile(const std::filesystem::path &path) throws { init(path); }
+    HDFFile() = default;
     HDFFile(const u8 *buf, isize len) throws { init(buf, len); }
     HDFFile(const class HardDrive &hdn) throws { init(hdn); }
 
@@ -55,6 +67,9 @@ public:
     void init(const u8 *buf, isize len) throws;
     void init(const class HardDrive &hdn) throws;
 
+    // Analyzes an externally owned image without copying it
+    void initView(const u8 *buf, isize len) throws;
+
     const char *objectName() const override { return "HDF"; }
 
     
@@ -138,6 +153,10 @@ public:
 
 private:
 
+    // Returns the raw disk data (the file data or the external image)
+    u8 *rawPtr() const { return image ? const_cast<u8 *>(image) : data.ptr; }
+    isize rawSize() const { return image ? imageSize : data.size; }
+
     // Returns a pointer to a certain block if it exists
     u8 *seekBlock(isize nr) const;
 
@@ -90,8 +90,8 @@ IMGFile::encodeDisk(FloppyDisk &disk) const
     isize tracks = numTracks();
     debug(IMG_DEBUG, "Encoding DOS disk with %ld tracks\n", tracks);
 
-    // Encode all tracks
-    for (Track t = 0; t < tracks; t++) encodeTrack(disk, t);
+    // Encode all tracks on demand
+    disk.encodeLazily(std::make_shared<IMGFile>(data.ptr, data.size), tracks);
 
     // In debug mode, also run the decoder
     if (IMG_DEBUG) {
@@ -11,6 +11,7 @@
 #include "Snapshot.h"
 #include "Amiga.h"
 #include "IOUtils.h"
+#include "Compression.h"
 
 namespace vamiga {
 
@@ -87,6 +88,8 @@ Snapshot::finalizeRead()
     if (isTooOld()) throw Error(ERROR_SNAP_TOO_OLD);
     if (isTooNew()) throw Error(ERROR_SNAP_TOO_NEW);
     if (isBeta() && !betaRelease) throw Error(ERROR_SNAP_IS_BETA);
+
+    if (getHeader()->compressed) uncompress();
 }
 
 std::pair <isize,isize>
@@ -145,4 +148,192 @@ Snapshot::takeScreenshot(Amiga &amiga)
     ((SnapshotHeader *)data.ptr)->screenshot.take(amiga);
 }
 
+isize
+Snapshot::compress(Amiga &amiga, std::ostream &stream)
+{
+    // Take a screenshot
+    auto thumbnail = std::make_unique<Thumbnail>();
+    thumbnail->take(amiga);
+
+    // Write the header and the thumbnail
+    isize result = writeHeader(stream, *thumbnail);
+
+    // Write the core data (one chunk per component)
+    amiga.save([&stream, &result](const u8 *buf, isize len) {
+        result += writeChunk(stream, buf, len);
+    });
+
+    // Write the end marker
+    result += writeChunk(stream, nullptr, 0);
+
+    if (!stream) throw Error(ERROR_FILE_CANT_WRITE);
+    return result;
+}
+
+isize
+Snapshot::writeToStream(std::ostream &stream)
+{
+    auto coreSize = data.size - isizeof(SnapshotHeader);
+
+    // Write the header and the thumbnail
+    isize result = writeHeader(stream, getThumbnail());
+
+    // Write the core data (single chunk) and the end marker
+    result += writeChunk(stream, getData(), coreSize);
+    result += writeChunk(stream, nullptr, 0);
+
+    if (!stream) throw Error(ERROR_FILE_CANT_WRITE);
+    return result;
+}
+
+isize
+Snapshot::writeToFile(const std::filesystem::path &path)
+{
+    if (util::isDirectory(path)) {
+        throw Error(ERROR_FILE_IS_DIRECTORY);
+    }
+
+    std::ofstream stream(path, std::ofstream::binary);
+
+    if (!stream.is_open()) {
+        throw Error(ERROR_FILE_CANT_WRITE, path);
+    }
+
+    return writeToStream(stream);
+}
+
+isize
+Snapshot::writeHeader(std::ostream &stream, const Thumbnail &thumbnail)
+{
+    u8 buf[prefixSize + 16] = { };
+    u8 *ptr = buf;
+
+    // Write the header
+    for (auto c : { 'V', 'A', 'S', 'N', 'A', 'P' }) write8(ptr, u8(c));
+    write8(ptr, SNP_MAJOR);
+    write8(ptr, SNP_MINOR);
+    write8(ptr, SNP_SUBMINOR);
+    write8(ptr, SNP_BETA);
+    write8(ptr, 1);
+    ptr = buf + prefixSize;
+
+    // Write the thumbnail
+    write32(ptr, u32(thumbnail.width));
+    write32(ptr, u32(thumbnail.height));
+    write64(ptr, u64(thumbnail.timestamp));
+    stream.write((char *)buf, sizeof(buf));
+
+    auto pixels = isize(thumbnail.width) * isize(thumbnail.height);
+    return isizeof(buf) + writeChunk(stream, (u8 *)thumbnail.screen, 4 * pixels);
+}
+
+isize
+Snapshot::writeChunk(std::ostream &stream, const u8 *buf, isize len)
+{
+    Buffer<u8> packed(util::maxCompressedSize(std::min(len, blockSize)));
+    u8 header[8], *ptr;
+    isize result = 4;
+
+    // Write the chunk size
+    ptr = header; write32(ptr, u32(len));
+    stream.write((char *)header, 4);
+
+    for (isize i = 0; i < len; i += blockSize) {
+
+        auto count = std::min(len - i, blockSize);
+
+        // Compress the block and fall back to raw data if it doesn't shrink
+        auto size = util::compress(buf + i, count, packed.ptr);
+        auto *src = size < count ? packed.ptr : buf + i;
+        if (size >= count) size = count;
+
+        // Write the block
+        ptr = header; write32(ptr, u32(count)); write32(ptr, u32(size));
+        stream.write((char *)header, 8);
+        stream.write((char *)src, size);
+
+        result += 8 + size;
+    }
+
+    return result;
+}
+
+isize
+Snapshot::readChunk(const u8 *&src, const u8 *end, u8 *dst, isize capacity)
+{
+    auto require = [&](isize bytes) {
+        if (end - src < bytes) throw Error(ERROR_SNAP_CORRUPTED);
+    };
+
+    require(4);
+    isize len = read32(src);
+    if (dst && len > capacity) throw Error(ERROR_SNAP_CORRUPTED);
+
+    for (isize i = 0; i < len;) {
+
+        require(8);
+        isize count = read32(src);
+        isize size = read32(src);
+        require(size);
+
+        if (count == 0 || count > len - i) throw Error(ERROR_SNAP_CORRUPTED);
+
+        if (dst) {
+
+            if (size == count) {
+                std::memcpy(dst + i, src, count);
+            } else if (util::decompress(src, size, dst + i, count) != count) {
+                throw Error(ERROR_SNAP_CORRUPTED);
+            }
+        }
+
+        src += size;
+        i += count;
+    }
+
+    return len;
+}
+
+void
+Snapshot::uncompress()
+{
+    const u8 *begin = data.ptr + prefixSize;
+    const u8 *end = data.ptr + data.size;
+    const u8 *src = begin;
+
+    if (end - src < 16) throw Error(ERROR_SNAP_CORRUPTED);
+    auto width = i32(read32(src));
+    auto height = i32(read32(src));
+    auto timestamp = time_t(read64(src));
+
+    // Determine the size of the thumbnail and the core data
+    auto pixels = readChunk(src, end, nullptr, 0);
+    isize coreSize = 0;
+    while (isize count = readChunk(src, end, nullptr, 0)) coreSize += count;
+
+    if (width < 0 || height < 0 || isize(width) * isize(height) * 4 != pixels) {
+        throw Error(ERROR_SNAP_CORRUPTED);
+    }
+
+    // Create a snapshot in raw format
+    Buffer<u8> raw(isizeof(SnapshotHeader) + coreSize);
+    std::memcpy(raw.ptr, data.ptr, prefixSize);
+
+    auto *header = (SnapshotHeader *)raw.ptr;
+    header->compressed = 0;
+    header->screenshot.width = width;
+    header->screenshot.height = height;
+    header->screenshot.timestamp = timestamp;
+
+    // Decompress the thumbnail and the core data
+    src = begin + 16;
+    readChunk(src, end, (u8 *)header->screenshot.screen, sizeof(header->screenshot.screen));
+
+    for (u8 *dst = raw.ptr + sizeof(SnapshotHeader); dst < raw.ptr + raw.size;) {
+        dst += readChunk(src, end, dst, raw.ptr + raw.size - dst);
+    }
+
+    data = raw;
+}
+
 }
@@ -40,15 +40,42 @@ struct SnapshotHeader {
     u8 subminor;
     u8 beta;
 
+    // Storage format (0 = raw, 1 = compressed)
+    u8 compressed;
+
     // Padding bytes
-    u8 reserved[6];
+    u8 reserved[5];
 
     // Preview image
     Thumbnail screenshot;
 };
 
+/* Snapshots are kept in memory in raw format, i.e., the header is followed by
+ * the serialized core data. When written to a stream, a compressed container
+ * is created instead which is organized as follows:
+ *
+ *   Header     : The first 16 bytes of the SnapshotHeader (compressed = 1)
+ *   Thumbnail  : Width (u32), height (u32), timestamp (u64), pixel chunk
+ *   Core data  : One chunk per component, terminated by an empty chunk
+ *
+ * A chunk starts with its uncompressed size (u32) and is stored as a sequence
+ * of independently compressed blocks. Each block starts with its uncompressed
+ * and its compressed size (u32, u32). Blocks that do not compress are stored
+ * verbatim. All integers are stored in big endian format.
+ *
+ * Only the write side is streamed. When a snapshot is read, finalizeRead()
+ * expands the container into the raw in-memory format before the state can
+ * be restored. Hence, loading requires the compressed file and the raw state
+ * to be held in memory at the same time.
+ */
 class Snapshot : public AmigaFile {
 
+    // Maximum number of uncompressed bytes in a single block
+    static constexpr isize blockSize = 0x40000;
+
+    // Size of the file header (the SnapshotHeader without the thumbnail)
+    static constexpr isize prefixSize = offsetof(SnapshotHeader, screenshot);
+
 public:
     
     static bool isCompatible(const std::filesystem::path &path);
@@ -104,6 +131,36 @@ public:
 
     // Takes a screenshot
     void takeScreenshot(Amiga &amiga);
+
+
+    //
+    // Compressing
+    //
+
+public:
+
+    // Writes a compressed snapshot without creating an in-memory copy first
+    static isize compress(Amiga &amiga, std::ostream &stream) throws;
+
+    // Writes this snapshot in compressed format
+    using AmigaFile::writeToStream;
+    using AmigaFile::writeToFile;
+    isize writeToStream(std::ostream &stream) throws override;
+    isize writeToFile(const std::filesystem::path &path) throws override;
+
+private:
+
+    // Writes the file header and the thumbnail image
+    static isize writeHeader(std::ostream &stream, const Thumbnail &thumbnail);
+
+    // Writes a chunk of data
+    static isize writeChunk(std::ostream &stream, const u8 *buf, isize len);
+
+    // Reads a chunk of data (pass nullptr to skip the chunk)
+    static isize readChunk(const u8 *&src, const u8 *end, u8 *dst, isize capacity) throws;
+
+    // Converts a compressed snapshot into the raw in-memory format
+    void uncompress() throws;
 };
 
 }
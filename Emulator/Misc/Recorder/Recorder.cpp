@@ -40,9 +40,40 @@ Recorder::_dump(Category category, std::ostream& os) const
         os << bol(FFmpeg::available()) << std::endl;
         os << tab("Recording");
         os << bol(isRecording()) << std::endl;
+        os << tab("Queued frames");
+        os << dec(tail - head) << " / " << dec(queueCapacity) << std::endl;
+        os << tab("Written frames");
+        os << dec(writtenFrames) << std::endl;
+        os << tab("Dropped frames");
+        os << dec(droppedFrames) << std::endl;
+        os << tab("Encode lag");
+        os << flt(encodeLag / 1000000.0) << " msec" << std::endl;
     }
 }
 
+void
+Recorder::cacheInfo(RecorderInfo &result) const
+{
+    {   SYNCHRONIZED
+
+        result.recording = isRecording();
+        result.duration = getDuration().asSeconds();
+        result.frameRate = frameRate;
+        result.bitRate = bitRate;
+        result.sampleRate = sampleRate;
+    }
+}
+
+void
+Recorder::cacheStats(RecorderStats &result) const
+{
+    result.queueDepth = tail - head;
+    result.queueCapacity = queueCapacity;
+    result.writtenFrames = writtenFrames;
+    result.droppedFrames = droppedFrames;
+    result.encodeLag = encodeLag / 1000000.0;
+}
+
 string
 Recorder::videoPipePath()
 {
@@ -125,8 +156,11 @@ Recorder::startRecording(isize x1, isize y1, isize x2, isize y2,
     // Create temporary buffers
     debug(REC_DEBUG, "Creating buffers...\n");
 
-    videoData.alloc((x2 - x1) * (y2 - y1));
-    audioData.alloc(2 * samplesPerFrame);
+    for (auto &frame : frames) {
+
+        frame.video.alloc((x2 - x1) * (y2 - y1));
+        frame.audio.alloc(2 * samplesPerFrame);
+    }
     
     //
     // Assemble the command line arguments for the video encoder
@@ -228,6 +262,9 @@ Recorder::startRecording(isize x1, isize y1, isize x2, isize y2,
         throw Error(ERROR_REC_LAUNCH, "Unable to launch the audio pipe.");
     }
     
+    // Launch the writer thread
+    startWriter();
+
     debug(REC_DEBUG, "Success\n");
     state = State::prepare;
 }
@@ -320,13 +357,39 @@ Recorder::record(Cycle target)
     assert(audioFFmpeg.isRunning());
     assert(videoPipe.isOpen());
     assert(audioPipe.isOpen());
-    
-    recordVideo(target);
-    recordAudio(target);
+
+    // Check if the writer thread has encountered an error
+    if (failed || FORCE_RECORDING_ERROR) {
+
+        state = State::abort;
+        return;
+    }
+
+    auto t = tail.load(std::memory_order_relaxed);
+
+    // Drop the frame if the writer thread has fallen behind
+    if (t - head.load(std::memory_order_acquire) >= queueCapacity) {
+
+        debug(REC_DEBUG, "Dropping frame (encoder lag: %lld usec)\n", (long long)(encodeLag / 1000));
+
+        audioClock = target;
+        droppedFrames++;
+        return;
+    }
+
+    // Record the frame into the next free slot
+    auto &frame = frames[t % queueCapacity];
+    recordVideo(frame, target);
+    recordAudio(frame, target);
+    frame.timestamp = util::Time::now();
+
+    // Hand the frame over to the writer thread
+    tail.store(t + 1, std::memory_order_release);
+    pending.release();
 }
 
 void
-Recorder::recordVideo(Cycle target)
+Recorder::recordVideo(Frame &frame, Cycle target)
 {
     auto *buffer = denise.pixelEngine.stablePtr();
 
@@ -334,24 +397,15 @@ Recorder::recordVideo(Cycle target)
     isize height = cutout.y2 - cutout.y1;
     isize offset = cutout.y1 * HPIXELS + cutout.x1;
     u8 *src = (u8 *)(buffer + offset);
-    u8 *dst = (u8 *)videoData.ptr;
+    u8 *dst = (u8 *)frame.video.ptr;
 
     for (isize y = 0; y < height; y++, src += sizeof(u32) * HPIXELS, dst += width) {
         std::memcpy(dst, src, width);
     }
-
-    // Feed the video pipe
-    assert(videoPipe.isOpen());
-    isize length = width * height;
-    isize written = videoPipe.write((u8 *)videoData.ptr, length);
-
-    if (written != length || FORCE_RECORDING_ERROR) {
-        state = State::abort;
-    }
 }
 
 void
-Recorder::recordAudio(Cycle target)
+Recorder::recordAudio(Frame &frame, Cycle target)
 {
     
     // Clone Paula's AudioPort contents
@@ -370,16 +424,7 @@ Recorder::recordAudio(Cycle target)
     audioClock = target;
     
     // Copy samples to buffer
-    audioPort.copyMono(audioData.ptr, samplesPerFrame);
-
-    // Feed the audio pipe
-    assert(audioPipe.isOpen());
-    isize length = 2 * sizeof(float) * samplesPerFrame;
-    isize written = audioPipe.write((u8 *)audioData.ptr, length);
-
-    if (written != length || FORCE_RECORDING_ERROR) {
-        state = State::abort;
-    }
+    audioPort.copyMono(frame.audio.ptr, samplesPerFrame);
 }
 
 void
@@ -387,6 +432,12 @@ Recorder::finalize()
 {
     debug(REC_DEBUG, "finalize()\n");
 
+    // Write all pending frames and terminate the writer thread
+    stopWriter();
+
+    debug(REC_DEBUG, "%ld frames written, %ld frames dropped\n",
+          isize(writtenFrames), isize(droppedFrames));
+
     // Close pipes
     videoPipe.close();
     audioPipe.close();
@@ -412,4 +463,68 @@ Recorder::abort()
     msgQueue.put(MSG_RECORDING_ABORTED);
 }
 
+void
+Recorder::startWriter()
+{
+    assert(!writer.joinable());
+
+    head = 0;
+    tail = 0;
+    quit = false;
+    failed = false;
+    writtenFrames = 0;
+    droppedFrames = 0;
+    encodeLag = 0;
+
+    writer = std::thread(&Recorder::writeFrames, this);
+}
+
+void
+Recorder::stopWriter()
+{
+    if (writer.joinable()) {
+
+        quit = true;
+        pending.release();
+        writer.join();
+    }
+}
+
+void
+Recorder::writeFrames()
+{
+    while (true) {
+
+        // Wait for the next frame or the termination request
+        pending.acquire();
+
+        auto h = head.load(std::memory_order_relaxed);
+        if (h == tail.load(std::memory_order_acquire)) {
+
+            if (quit) break; else continue;
+        }
+
+        auto &frame = frames[h % queueCapacity];
+
+        // Feed the pipes (skipped if a previous write has failed)
+        if (!failed) {
+
+            isize videoLength = frame.video.bytesize();
+            isize audioLength = frame.audio.bytesize();
+
+            if (videoPipe.write((u8 *)frame.video.ptr, videoLength) != videoLength ||
+                audioPipe.write((u8 *)frame.audio.ptr, audioLength) != audioLength) {
+
+                failed = true;
+            }
+        }
+
+        encodeLag = (util::Time::now() - frame.timestamp).asNanoseconds();
+        writtenFrames++;
+
+        // Release the slot
+        head.store(h + 1, std::memory_order_release);
+    }
+}
+
 }
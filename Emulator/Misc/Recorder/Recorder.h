@@ -10,17 +10,27 @@
 #pragma once
 
 #include "SubComponent.h"
+#include "RecorderTypes.h"
 #include "Buffer.h"
 #include "Chrono.h"
 #include "FFmpeg.h"
 #include "AudioPort.h"
 #include "NamedPipe.h"
+#include <atomic>
+#include <semaphore>
+#include <thread>
 
 namespace vamiga {
 
 using util::Buffer;
 
-class Recorder : public SubComponent {
+/* Recorded frames are handed over to a separate writer thread which feeds
+ * the FFmpeg pipes. This way, the emulator thread never blocks if an encoder
+ * falls behind. Frames are passed via a bounded single-producer single-consumer
+ * ring buffer of preallocated frame buffers. If the ring buffer is full, the
+ * frame is dropped (both audio and video to keep the streams in sync).
+ */
+class Recorder : public SubComponent, public Inspectable<RecorderInfo, RecorderStats> {
 
     Descriptions descriptions = {{
 
@@ -89,9 +99,43 @@ class Recorder : public SubComponent {
     util::Time recStart;
     util::Time recStop;
 
-    // Temporary storage for audio and video data
-    Buffer<u32> videoData;
-    Buffer<float> audioData;
+
+    //
+    // Frame queue
+    //
+
+    // Maximum number of frames waiting to be written
+    static constexpr isize queueCapacity = 8;
+
+    // A recorded frame
+    struct Frame {
+
+        Buffer<u32> video;
+        Buffer<float> audio;
+        util::Time timestamp;
+    };
+
+    // Frame pool (used as a ring buffer)
+    Frame frames[queueCapacity];
+
+    // Read and write position (only modified by the consumer or producer)
+    std::atomic<isize> head = 0;
+    std::atomic<isize> tail = 0;
+
+    // Wakes up the writer thread
+    std::counting_semaphore<queueCapacity + 1> pending{0};
+
+    // The writer thread
+    std::thread writer;
+
+    // Communication flags between the emulator thread and the writer thread
+    std::atomic<bool> quit = false;
+    std::atomic<bool> failed = false;
+
+    // Statistics
+    std::atomic<isize> writtenFrames = 0;
+    std::atomic<isize> droppedFrames = 0;
+    std::atomic<i64> encodeLag = 0;
 
     
     //
@@ -101,6 +145,7 @@ class Recorder : public SubComponent {
 public:
     
     Recorder(Amiga& ref);
+    ~Recorder() { stopWriter(); }
     
     Recorder& operator= (const Recorder& other) {
 
@@ -142,6 +187,16 @@ private:
     void _initialize() override;
 
 
+    //
+    // Methods from Inspectable
+    //
+
+private:
+
+    void cacheInfo(RecorderInfo &result) const override;
+    void cacheStats(RecorderStats &result) const override;
+
+
     //
     // Methods from Configurable
     //
@@ -213,10 +268,24 @@ private:
     
     void prepare();
     void record(Cycle target);
-    void recordVideo(Cycle target);
-    void recordAudio(Cycle target);
+    void recordVideo(Frame &frame, Cycle target);
+    void recordAudio(Frame &frame, Cycle target);
     void finalize();
     void abort();
+
+
+    //
+    // Writing frames
+    //
+
+private:
+
+    // Main function of the writer thread
+    void writeFrames();
+
+    // Launches or terminates the writer thread
+    void startWriter();
+    void stopWriter();
 };
 
 }
@@ -0,0 +1,45 @@
+// -----------------------------------------------------------------------------
+// This file is part of vAmiga
+//
+// Copyright (C) Dirk W. Hoffmann. www.dirkwhoffmann.de
+// Licensed under the Mozilla Public License v2
+//
+// See https://mozilla.org/MPL/2.0 for license information
+// -----------------------------------------------------------------------------
+
+#pragma once
+
+#include "BasicTypes.h"
+
+//
+// Structures
+//
+
+typedef struct
+{
+    bool recording;
+    double duration;
+    isize frameRate;
+    isize bitRate;
+    isize sampleRate;
+}
+RecorderInfo;
+
+typedef struct
+{
+    //! Number of frames waiting to be written into the encoder pipes
+    isize queueDepth;
+
+    //! Maximum number of frames the queue can hold
+    isize queueCapacity;
+
+    //! Number of frames handed over to the encoders
+    isize writtenFrames;
+
+    //! Number of frames dropped because the encoders fell behind
+    isize droppedFrames;
+
+    //! Time between capturing and writing the latest frame in milliseconds
+    double encodeLag;
+}
+RecorderStats;
@@ -11,8 +11,11 @@
 #include "RegressionTester.h"
 #include "Emulator.h"
 #include "IOUtils.h"
+#include "ADFFile.h"
 
 #include <fstream>
+#include <iomanip>
+#include <random>
 
 namespace vamiga {
 
@@ -63,18 +66,17 @@ void
 RegressionTester::dumpTexture(Amiga &amiga, const string &filename)
 {
     /* This function is used for automatic regression testing. It dumps the
-     * visible portion of the texture into the /tmp directory and exits the
+     * visible portion of the texture into the output directory and exits the
      * application. The regression test script picks up the texture and
      * compares it against a previously recorded reference image.
      */
-    std::ofstream file;
+    auto path = texturePath(filename);
+    std::ofstream file(path, std::ios::binary);
 
-    // Open an output stream
-    file.open(("/tmp/" + filename + ".raw").c_str());
-    
     // Dump texture
     dumpTexture(amiga, file);
     file.close();
+    if (!file) throw Error(ERROR_FILE_CANT_WRITE, path);
 
     // Ask the GUI to quit
     msgQueue.put(MSG_ABORT, retValue);
@@ -82,35 +84,551 @@ RegressionTester::dumpTexture(Amiga &amiga, const string &filename)
 
 void
 RegressionTester::dumpTexture(Amiga &amiga, std::ostream& os)
+{
+    Buffer<u8> image;
+
+    grabTexture(amiga, image);
+    os.write((char *)image.ptr, image.size);
+}
+
+u64
+RegressionTester::computeChecksum(Amiga &amiga)
+{
+    Buffer<u8> image;
+
+    grabTexture(amiga, image);
+    return image.fnv64();
+}
+
+void
+RegressionTester::verifyTexture(Amiga &amiga, u64 expected)
+{
+    /* This function is the in-process counterpart of dumpTexture(). Instead
+     * of writing the test image to disk, it compares a checksum of the image
+     * with the expected value. The checksum matches the FNV-64 hash of the
+     * raw file created by dumpTexture(). The test image is only written if
+     * the checksums differ.
+     */
+    Buffer<u8> image;
+
+    grabTexture(amiga, image);
+    auto checksum = image.fnv64();
+    auto code = retValue;
+
+    if (checksum != expected) {
+
+        retroShell << "Checksum mismatch: Expected " << util::hexstr<16>(expected);
+        retroShell << ", got " << util::hexstr<16>(checksum) << "\n";
+
+        // Dump the test image for inspection
+        auto path = texturePath(dumpTexturePath);
+        std::ofstream file(path, std::ios::binary);
+        file.write((char *)image.ptr, image.size);
+        file.close();
+
+        if (file) {
+            retroShell << "Test image written to " << path << "\n";
+        } else {
+            retroShell << "Failed to write " << path << "\n";
+        }
+
+        // Make sure the test script recognizes the failure
+        if (code == 0) code = 1;
+    }
+
+    // Ask the GUI to quit
+    msgQueue.put(MSG_ABORT, code);
+}
+
+string
+RegressionTester::texturePath(const string &filename) const
+{
+    return dumpTextureDir + "/" + filename + ".raw";
+}
+
+void
+RegressionTester::grabTexture(Amiga &amiga, Buffer<u8> &image)
 {
     Texel grey2 = FrameBuffer::grey2;
     Texel grey4 = FrameBuffer::grey4;
 
     auto checkerboard = [&](isize y, isize x) {
-        return ((y >> 3) & 1) == ((x >> 3) & 1) ? (char *)&grey2 : (char *)&grey4;
+        return ((y >> 3) & 1) == ((x >> 3) & 1) ? (u8 *)&grey2 : (u8 *)&grey4;
     };
 
+    image.alloc((Y2 - Y1) * (X2 - X1) * 3);
+    u8 *dst = image.ptr;
+
     {   SUSPENDED
         
         Texel *ptr = amiga.denise.pixelEngine.stablePtr() - 4 * HBLANK_MIN;
-        char *cptr;
+        u8 *src;
 
         for (isize y = Y1; y < Y2; y++) {
             
             for (isize x = X1; x < X2; x++) {
 
                 if (y >= y1 && y < y2 && x >= x1 && x < x2) {
-                    cptr = (char *)(ptr + y * HPIXELS + x);
+                    src = (u8 *)(ptr + y * HPIXELS + x);
                 } else {
-                    cptr = checkerboard(y, x);
+                    src = checkerboard(y, x);
                 }
 
-                os.write(cptr + 0, 1);
-                os.write(cptr + 1, 1);
-                os.write(cptr + 2, 1);
+                *dst++ = src[0];
+                *dst++ = src[1];
+                *dst++ = src[2];
+            }
+        }
+    }
+}
+
+void
+RegressionTester::benchmarkBitplanes(std::ostream &os)
+{
+    typedef void (Denise::*DrawFunc)();
+
+    static constexpr Resolution modes[3] = { LORES, HIRES, SHRES };
+    static constexpr const char *names[3] = { "Lores", "Hires", "Shres" };
+    static constexpr DrawFunc funcs[3] = {
+
+        &Denise::drawLoresBoth, &Denise::drawHiresBoth, &Denise::drawShresBoth
+    };
+
+    // Remember the state that is modified below
+    auto pos = agnus.pos;
+    auto bplcon0 = denise.bplcon0;
+    auto offsetOdd = denise.pixelOffsetOdd;
+    auto offsetEven = denise.pixelOffsetEven;
+    auto armedOdd = denise.armedOdd;
+    auto armedEven = denise.armedEven;
+    u16 pipe[6], shift[6];
+    std::memcpy(pipe, denise.bpldatPipe, sizeof(pipe));
+    std::memcpy(shift, denise.shiftReg, sizeof(shift));
+    std::vector<u8> buffer(std::begin(denise.dBuffer), std::end(denise.dBuffer));
+
+    std::mt19937 rng(0);
+    std::vector<u8> expected(buffer.size());
+
+    for (isize m = 0; m < 3; m++) {
+
+        auto draw = funcs[m];
+        isize errors = 0;
+
+        // Compare both implementations with random data
+        for (isize i = 0; i < 7 * 2000; i++) {
+
+            denise.bplcon0 = u16((i % 7) << 12);
+            denise.pixelOffsetOdd = Pixel(rng() % 16);
+            denise.pixelOffsetEven = Pixel(rng() % 16);
+            agnus.pos.h = 0x20 + rng() % 0x80;
+            for (auto &p : denise.dBuffer) p = u8(rng());
+
+            u16 random[12];
+            for (auto &r : random) r = u16(rng());
+
+            denise.armedOdd = denise.armedEven = true;
+            std::memcpy(denise.bpldatPipe, random, 12);
+            std::memcpy(denise.shiftReg, random + 6, 12);
+            auto saved = std::vector<u8>(std::begin(denise.dBuffer), std::end(denise.dBuffer));
+
+            drawBitplanes(modes[m], true);
+            drawBitplanes(modes[m], false);
+            std::copy(std::begin(denise.dBuffer), std::end(denise.dBuffer), expected.begin());
+
+            denise.armedOdd = denise.armedEven = true;
+            std::memcpy(denise.bpldatPipe, random, 12);
+            std::memcpy(denise.shiftReg, random + 6, 12);
+            std::copy(saved.begin(), saved.end(), std::begin(denise.dBuffer));
+
+            (denise.*draw)();
+            if (!std::equal(expected.begin(), expected.end(), std::begin(denise.dBuffer))) errors++;
+        }
+
+        // Measure the average execution time with six bitplanes
+        constexpr isize calls = 1000000;
+        denise.bplcon0 = 6 << 12;
+
+        util::Clock clock1;
+        for (isize i = 0; i < calls; i++) {
+
+            denise.armedOdd = denise.armedEven = true;
+            denise.bpldatPipe[i % 6] = u16(i * 0x9E37);
+            agnus.pos.h = 0x20 + (i & 0x3F);
+            (denise.*draw)();
+        }
+        auto fast = clock1.stop().asNanoseconds();
+
+        util::Clock clock2;
+        for (isize i = 0; i < calls; i++) {
+
+            denise.armedOdd = denise.armedEven = true;
+            denise.bpldatPipe[i % 6] = u16(i * 0x9E37);
+            agnus.pos.h = 0x20 + (i & 0x3F);
+            drawBitplanes(modes[m], true);
+            drawBitplanes(modes[m], false);
+        }
+        auto slow = clock2.stop().asNanoseconds();
+
+        os << names[m] << ": " << std::fixed << std::setprecision(1);
+        os << double(fast) / calls << " ns per call (reference: ";
+        os << double(slow) / calls << " ns), ";
+        os << (errors ? std::to_string(errors) + " mismatches" : "no mismatches") << std::endl;
+    }
+
+    // Restore the original state
+    agnus.pos = pos;
+    denise.bplcon0 = bplcon0;
+    denise.pixelOffsetOdd = offsetOdd;
+    denise.pixelOffsetEven = offsetEven;
+    denise.armedOdd = armedOdd;
+    denise.armedEven = armedEven;
+    std::memcpy(denise.bpldatPipe, pipe, sizeof(pipe));
+    std::memcpy(denise.shiftReg, shift, sizeof(shift));
+    std::copy(buffer.begin(), buffer.end(), std::begin(denise.dBuffer));
+}
+
+void
+RegressionTester::benchmarkBlitter(std::ostream &os)
+{
+    auto chip = mem.chip;
+    auto chipSize = isize(mem.getConfig().chipSize);
+
+    // Remember the state that is modified below
+    SerCounter counter;
+    blitter << counter;
+    Buffer<u8> state(counter.count);
+    SerWriter writer(state.ptr);
+    blitter << writer;
+    Buffer<u8> ram(chip, chipSize);
+    auto dataBus = mem.dataBus;
+
+    // Runs the current blit on the raw path or the word-by-word path
+    auto blit = [&](bool raw) {
+
+        if (raw) return blitter.doRawCopyBlit();
+
+        auto nr = ((blitter.bltcon0 >> 7) & 0b11110) | (blitter.bltconDESC() ? 1 : 0);
+        (blitter.*(blitter.blitfunc[nr]))();
+        return true;
+    };
+
+    //
+    // Compare both paths with random blits
+    //
+
+    static constexpr u8 minterms[] = {
+
+        0x00, 0xFF, 0xF0, 0xCA, 0xFC, 0x0A, 0x3C, 0x96, 0x5A, 0x12
+    };
+
+    std::mt19937 rng(0);
+    Buffer<u8> init(chipSize), expected(chipSize);
+    for (isize i = 0; i < chipSize; i++) init[i] = u8(rng());
+
+    isize count = 20000, raw = 0, errors = 0;
+
+    for (isize i = 0; i < count; i++) {
+
+        auto con0 = (rng() % 16) << 12 | (rng() % 16) << 8 | minterms[rng() % 10];
+        auto con1 = (rng() % 16) << 12 | (rng() % 2 ? 2 : 0) | (rng() % 2 ? 4 : 0);
+        if (rng() % 4 == 0) con1 |= rng() % 2 ? 8 : 16;
+        auto ptr = [&]() { return u32(rng() % (i % 50 ? chipSize : 0x100000)) & ~1U; };
+        auto mod = [&]() { return i16(2 * (rng() % 80) - 80); };
+
+        blitter.bltcon0 = u16(con0);
+        blitter.bltcon1 = u16(con1);
+        blitter.bltsizeH = u16(1 + rng() % 20);
+        blitter.bltsizeV = u16(1 + rng() % 30);
+        blitter.bltafwm = u16(rng());
+        blitter.bltalwm = u16(rng());
+        blitter.bltamod = mod();
+        blitter.bltbmod = mod();
+        blitter.bltcmod = mod();
+        blitter.bltdmod = mod();
+        blitter.bltapt = ptr();
+        blitter.bltbpt = ptr();
+        blitter.bltcpt = ptr();
+        blitter.bltdpt = ptr();
+        blitter.anew = u16(rng());
+        blitter.bnew = u16(rng());
+        blitter.bhold = u16(rng());
+        blitter.chold = u16(rng());
+        blitter.ahold = blitter.dhold = 0;
+        blitter.bzero = true;
+        mem.dataBus = 0;
+
+        // Save the registers that are modified by a blit
+        auto registers = [&]() {
+
+            return std::tuple(blitter.bltapt, blitter.bltbpt, blitter.bltcpt, blitter.bltdpt,
+                              blitter.anew, blitter.bnew, blitter.aold, blitter.bold,
+                              blitter.ahold, blitter.bhold, blitter.chold, blitter.dhold,
+                              blitter.bzero, mem.dataBus);
+        };
+        auto before = registers();
+
+        std::memcpy(chip, init.ptr, chipSize);
+        blit(false);
+        auto after = registers();
+        std::memcpy(expected.ptr, chip, chipSize);
+
+        std::tie(blitter.bltapt, blitter.bltbpt, blitter.bltcpt, blitter.bltdpt,
+                 blitter.anew, blitter.bnew, blitter.aold, blitter.bold,
+                 blitter.ahold, blitter.bhold, blitter.chold, blitter.dhold,
+                 blitter.bzero, mem.dataBus) = before;
+
+        // Blits which don't fit into Chip Ram are not processed by the raw path
+        std::memcpy(chip, init.ptr, chipSize);
+        if (!blit(true)) continue;
+
+        raw++;
+        if (registers() != after || std::memcmp(chip, expected.ptr, chipSize)) errors++;
+    }
+
+    os << "Random blits: " << count << " (" << raw << " on the raw path), ";
+    os << (errors ? std::to_string(errors) + " mismatches" : "no mismatches") << std::endl;
+
+    //
+    // Measure the throughput (320 x 256 pixel area, all channels enabled)
+    //
+
+    static constexpr struct { const char *name; std::initializer_list<u8> minterms; } classes[] = {
+
+        { "Constant", { 0x00, 0xFF } },
+        { "1-input ", { 0xF0, 0xCC, 0x0F } },
+        { "2-input ", { 0xFC, 0x0A, 0x3C } },
+        { "3-input ", { 0xCA, 0x96, 0xE2, 0x1D } }
+    };
+
+    constexpr isize words = 20 * 256, repetitions = 50;
+
+    auto measure = [&](u8 minterm, bool raw) {
+
+        i64 best = INT64_MAX;
+
+        for (isize run = 0; run < 5; run++) {
+
+            util::Clock clock;
+
+            for (isize i = 0; i < repetitions; i++) {
+
+                blitter.bltcon0 = 0x0F00 | minterm;
+                blitter.bltcon1 = 0;
+                blitter.bltsizeH = 20;
+                blitter.bltsizeV = 256;
+                blitter.bltafwm = blitter.bltalwm = 0xFFFF;
+                blitter.bltamod = blitter.bltbmod = blitter.bltcmod = blitter.bltdmod = 0;
+                blitter.bltapt = 0x10000;
+                blitter.bltbpt = 0x20000;
+                blitter.bltcpt = blitter.bltdpt = 0x30000;
+                blit(raw);
+            }
+            best = std::min(best, clock.stop().asNanoseconds());
+        }
+
+        // Return the number of words per microsecond (Mwords/s)
+        return double(words * repetitions) / double(std::max(best, i64(1))) * 1000.0;
+    };
+
+    os << std::fixed << std::setprecision(1);
+    for (auto &c : classes) {
+
+        double fast = 0, slow = 0;
+        for (auto minterm : c.minterms) {
+
+            fast += measure(minterm, true);
+            slow += measure(minterm, false);
+        }
+        fast /= double(c.minterms.size());
+        slow /= double(c.minterms.size());
+
+        os << c.name << ": " << std::setw(6) << fast << " Mwords/s (word by word: ";
+        os << std::setw(5) << slow << " Mwords/s)" << std::endl;
+    }
+
+    // Restore the original state
+    SerReader reader(state.ptr);
+    blitter << reader;
+    std::memcpy(chip, ram.ptr, chipSize);
+    mem.touchChip(0, u32(chipSize - 1));
+    mem.dataBus = dataBus;
+}
+
+void
+RegressionTester::benchmarkCopper(std::ostream &os)
+{
+    static constexpr isize lines[] = { 262, 263, 312, 313 };
+
+    struct Case { u32 beam; u32 comp; u32 mask; isize numLines; };
+
+    // Create random WAIT commands, favoring masks with many bits set
+    std::mt19937 rng(0);
+    std::vector<Case> cases(1000000);
+
+    for (auto &c : cases) {
+
+        c.numLines = lines[rng() % 4];
+        c.beam = u32(rng() % (c.numLines + 1)) << 8 | u32(rng() % 0xE4);
+        c.comp = rng() & 0xFFFE;
+        c.mask = ((rng() % 2 ? 0x7FFE : rng()) & 0x7FFE & (rng() | rng())) | 0x8001;
+    }
+
+    // Compare the closed-form search with the line-by-line scan
+    isize errors = 0;
+    for (auto &c : cases) {
+
+        auto expected = copper.scanMatch(c.beam, c.comp, c.mask, c.numLines);
+        if (copper.computeMatch(c.beam, c.comp, c.mask, c.numLines) != expected) {
+
+            if (errors++ < 8) {
+
+                os << "Mismatch: beam = " << util::hexstr<6>(c.beam);
+                os << " VPHP = " << util::hexstr<4>(c.comp);
+                os << " VMHM = " << util::hexstr<4>(c.mask);
+                os << " lines = " << c.numLines << std::endl;
+            }
+        }
+    }
+
+    // Measure the average execution time
+    auto measure = [&](auto func) {
+
+        // Accumulate the results to keep the compiler from removing the loop
+        volatile i64 sum = 0;
+
+        util::Clock clock;
+        for (auto &c : cases) sum = sum + func(c);
+        auto elapsed = clock.stop().asNanoseconds();
+
+        return double(elapsed) / double(cases.size());
+    };
+
+    auto fast = measure([&](const Case &c) {
+        return copper.computeMatch(c.beam, c.comp, c.mask, c.numLines); });
+    auto slow = measure([&](const Case &c) {
+        return copper.scanMatch(c.beam, c.comp, c.mask, c.numLines); });
+
+    os << "Random WAITs: " << cases.size() << ", ";
+    os << (errors ? std::to_string(errors) + " mismatches" : "no mismatches") << std::endl;
+    os << std::fixed << std::setprecision(1);
+    os << "Closed form: " << fast << " ns per call (line by line: " << slow << " ns)" << std::endl;
+}
+
+void
+RegressionTester::benchmarkMfm(std::ostream &os)
+{
+    ADFFile adf(INCH_35, DENSITY_DD), result(INCH_35, DENSITY_DD);
+    FloppyDisk disk(INCH_35, DENSITY_DD);
+    disk.clearDisk();
+
+    auto tracks = adf.numTracks();
+    auto bytes = adf.data.size;
+
+    std::mt19937 rng(0);
+    i64 encode = INT64_MAX, decode = INT64_MAX;
+    isize runs = 20, errors = 0;
+
+    for (isize run = 0; run < runs; run++) {
+
+        // Fill all sectors with random data
+        for (isize i = 0; i < bytes; i++) adf.data[i] = u8(rng());
+
+        // Encode all tracks
+        util::Clock clock1;
+        for (Track t = 0; t < tracks; t++) adf.encodeTrack(disk, t);
+        encode = std::min(encode, clock1.stop().asNanoseconds());
+
+        // Decode all tracks
+        util::Clock clock2;
+        result.decodeDisk(disk);
+        decode = std::min(decode, clock2.stop().asNanoseconds());
+
+        if (std::memcmp(adf.data.ptr, result.data.ptr, bytes)) errors++;
+    }
+
+    // Return the number of bytes per microsecond (MB/s)
+    auto throughput = [&](i64 ns) { return double(bytes) / double(std::max(ns, i64(1))) * 1000.0; };
+
+    os << "Random disks: " << runs << " (" << tracks * adf.numSectors() << " sectors each), ";
+    os << (errors ? std::to_string(errors) + " mismatches" : "no mismatches") << std::endl;
+    os << std::fixed << std::setprecision(1);
+    os << "Encoding: " << std::setw(7) << throughput(encode) << " MB/s" << std::endl;
+    os << "Decoding: " << std::setw(7) << throughput(decode) << " MB/s" << std::endl;
+}
+
+void
+RegressionTester::drawBitplanes(Resolution mode, bool odd)
+{
+    bool &armed = odd ? denise.armedOdd : denise.armedEven;
+    if (!armed) return;
+
+    u8 planes = odd ? 0b010101 : 0b101010;
+    u8 keep = u8(~planes & 0x3F);
+    u8 mask = 0;
+
+    // Number of enabled bitplanes (BPLCON0 is assumed to be valid)
+    isize bpu = (denise.bplcon0 >> 12) & 0b111;
+
+    // Update the shift registers
+    for (isize n = 0; n < 6; n++) {
+
+        if ((planes & (1 << n)) && n < bpu) {
+
+            denise.shiftReg[n] = denise.bpldatPipe[n];
+            mask |= u8(1 << n);
+        }
+    }
+
+    // Assembles the bitplane index of a single pixel
+    auto index = [&](isize i) {
+
+        u8 result = 0;
+        for (isize n = 0; n < 6; n++) {
+            if (planes & (1 << n)) result |= u8(((denise.shiftReg[n] >> (15 - i)) & 1) << n);
+        }
+        return u8(result & mask);
+    };
+
+    auto offset = odd ? denise.pixelOffsetOdd : denise.pixelOffsetEven;
+    u8 *p = denise.dBuffer + agnus.pos.pixel() + offset + 2;
+
+    switch (mode) {
+
+        case LORES:
+
+            for (isize i = 0; i < 16; i++) {
+
+                p[2 * i] = u8((p[2 * i] & keep) | index(i));
+                p[2 * i + 1] = u8((p[2 * i + 1] & keep) | index(i));
+            }
+            break;
+
+        case HIRES:
+
+            for (isize i = 0; i < 16; i++) {
+
+                p[i] = u8((p[i] & keep) | index(i));
             }
+            break;
+
+        default:
+        {
+            u8 keep1 = odd ? 0b111011 : 0b110111;
+            u8 keep2 = odd ? 0b111110 : 0b111101;
+
+            for (isize i = 0; i < 8; i++) {
+
+                p[i] = u8((((p[i] & keep1) | index(2 * i) << 2) & keep2) | index(2 * i + 1));
+            }
+            break;
         }
     }
+
+    // Clear the shift registers
+    for (isize n = 0; n < 6; n++) {
+        if (planes & (1 << n)) denise.shiftReg[n] = 0;
+    }
+    armed = false;
 }
 
 void
@@ -12,9 +12,12 @@
 #include "SubComponent.h"
 #include "Constants.h"
 #include "AmigaTypes.h"
+#include "Buffer.h"
 
 namespace vamiga {
 
+using util::Buffer;
+
 class RegressionTester : public SubComponent {
 
     Descriptions descriptions = {{
@@ -36,7 +39,8 @@ class RegressionTester : public SubComponent {
 
 public:
 
-    // Filename of the test image
+    // Output directory and filename of the test image
+    string dumpTextureDir = "/tmp";
     string dumpTexturePath = "texture";
 
     // Pixel area which is written to the test image
@@ -113,7 +117,57 @@ public:
     void dumpTexture(Amiga &amiga, const string &filename);
     void dumpTexture(Amiga &amiga, std::ostream& os);
 
+    // Computes a checksum over the test image
+    u64 computeChecksum(Amiga &amiga);
+
+    // Compares the test image with a checksum and exits the emulator
+    void verifyTexture(Amiga &amiga, u64 expected);
+
+private:
+
+    // Returns the path of a test image inside the output directory
+    string texturePath(const string &filename) const;
+
+    // Copies the test image into a buffer (3 bytes per pixel)
+    void grabTexture(Amiga &amiga, Buffer<u8> &image);
+
     
+    //
+    // Running microbenchmarks
+    //
+
+public:
+
+    /* Compares the bitplane drawing routines with a bit-by-bit reference
+     * implementation. The results of both implementations are checked for
+     * equality and the average time per call is reported.
+     */
+    void benchmarkBitplanes(std::ostream &os);
+
+    /* Compares the raw Chip Ram path of the Fast Blitter with the word-by-word
+     * path. A series of random blits is checked for equal results and the
+     * throughput of both paths is reported for several classes of minterms.
+     */
+    void benchmarkBlitter(std::ostream &os);
+
+    /* Compares the closed-form search for the trigger position of a Copper
+     * WAIT with the line-by-line scan for a series of random WAIT commands.
+     * Mismatches and the average time per search are reported.
+     */
+    void benchmarkCopper(std::ostream &os);
+
+    /* Round-trips disks filled with random sectors through the MFM encoder
+     * and decoder of the ADF format. The decoded sectors are checked against
+     * the original data and the throughput of both directions is reported.
+     */
+    void benchmarkMfm(std::ostream &os);
+
+private:
+
+    // Reference implementation of Denise::drawXxxOdd() and drawXxxEven()
+    void drawBitplanes(Resolution mode, bool odd);
+
+
     //
     // Handling errors
     //
@@ -15,8 +15,6 @@
 
 namespace vamiga {
 
-string Command::currentGroup;
-
 void
 Command::add(const std::vector<string> &tokens,
              const string &help,
@@ -44,8 +44,8 @@ static const std::string string     = "<string>";
 
 struct Command {
 
-    // Used during command registration
-    static string currentGroup;
+    // Used during command registration (only relevant for the root node)
+    string currentGroup;
 
     // Group of this command
     string groupName;
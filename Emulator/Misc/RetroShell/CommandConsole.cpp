@@ -14,7 +14,7 @@
 
 namespace vamiga {
 
-#define VAMIGA_GROUP(x) Command::currentGroup = x;
+#define VAMIGA_GROUP(x) root.currentGroup = x;
 
 void
 CommandConsole::_pause()
@@ -206,6 +206,45 @@ CommandConsole::initCommands(Command &root)
 
                 amiga.regressionTester.run(argv.front());
             });
+
+            root.add({"regression", "bench"},
+                     "Runs a microbenchmark");
+
+            root.add({"regression", "bench", "bitplanes"},
+                     "Benchmarks the planar-to-chunky conversion",
+                     [this](Arguments& argv, long value) {
+
+                std::stringstream ss;
+                amiga.regressionTester.benchmarkBitplanes(ss);
+                *this << ss;
+            });
+
+            root.add({"regression", "bench", "blitter"},
+                     "Benchmarks the Fast Blitter",
+                     [this](Arguments& argv, long value) {
+
+                std::stringstream ss;
+                amiga.regressionTester.benchmarkBlitter(ss);
+                *this << ss;
+            });
+
+            root.add({"regression", "bench", "copper"},
+                     "Cross-checks the Copper WAIT search",
+                     [this](Arguments& argv, long value) {
+
+                std::stringstream ss;
+                amiga.regressionTester.benchmarkCopper(ss);
+                *this << ss;
+            });
+
+            root.add({"regression", "bench", "mfm"},
+                     "Benchmarks the MFM encoder and decoder",
+                     [this](Arguments& argv, long value) {
+
+                std::stringstream ss;
+                amiga.regressionTester.benchmarkMfm(ss);
+                *this << ss;
+            });
         }
 
         root.add({"screenshot"}, debugBuild ? "Manages screenshots" : "");
@@ -222,6 +261,15 @@ CommandConsole::initCommands(Command &root)
                 amiga.regressionTester.dumpTexturePath = argv.front();
             });
 
+            root.add({"screenshot", "set", "directory"}, { Arg::path },
+                     "Assigns the screen shot output directory",
+                     [this](Arguments& argv, long value) {
+
+                auto path = argv.front();
+                if (!util::isDirectory(path)) throw Error(ERROR_DIR_NOT_FOUND, path);
+                amiga.regressionTester.dumpTextureDir = path;
+            });
+
             root.add({"screenshot", "set", "cutout"}, { Arg::value, Arg::value, Arg::value, Arg::value },
                      "Adjusts the texture cutout",
                      [this](Arguments& argv, long value) {
@@ -243,6 +291,26 @@ CommandConsole::initCommands(Command &root)
 
                 amiga.regressionTester.dumpTexture(amiga, argv.front());
             });
+
+            root.add({"screenshot", "checksum"},
+                     "Computes a checksum of the screenshot",
+                     [this](Arguments& argv, long value) {
+
+                auto checksum = amiga.regressionTester.computeChecksum(amiga);
+                *this << util::hexstr<16>(checksum) << '\n';
+            });
+
+            root.add({"screenshot", "verify"}, { Arg::value },
+                     "Compares the screenshot with a checksum and exits the emulator",
+                     [this](Arguments& argv, long value) {
+
+                u64 expected;
+
+                try { expected = std::stoull(argv.front(), nullptr, 16); }
+                catch (std::exception &) { throw util::ParseNumError(argv.front()); }
+
+                amiga.regressionTester.verifyTexture(amiga, expected);
+            });
         }
     }
 
@@ -460,6 +528,26 @@ CommandConsole::initCommands(Command &root)
             initSetters(root, blitter);
         }
 
+        //
+        // Copper
+        //
+
+        cmd = copper.shellName();
+        description = copper.description();
+        root.add({cmd}, description);
+
+        {   VAMIGA_GROUP("")
+
+            root.add({cmd, ""},
+                     "Displays the current configuration",
+                     [this](Arguments& argv, long value) {
+
+                dump(copper, Category::Config);
+            });
+
+            initSetters(root, copper);
+        }
+
 
         //
         // Denise
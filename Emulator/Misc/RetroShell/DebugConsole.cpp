@@ -13,7 +13,7 @@
 
 namespace vamiga {
 
-#define VAMIGA_GROUP(x) Command::currentGroup = x;
+#define VAMIGA_GROUP(x) root.currentGroup = x;
 
 void
 DebugConsole::_pause()
@@ -107,6 +107,14 @@ DebugConsole::initCommands(Command &root)
 
         root.clone("n", {"next"});
 
+        root.add({"rewind"}, { }, { Arg::count },
+                 "Step back in time",
+                 [this](Arguments& argv, long value) {
+
+            auto frames = emulator.rewind(parseNum(argv, 0, 1));
+            *this << "Rewound " << frames << (frames == 1 ? " frame\n" : " frames\n");
+        });
+
         root.add({"break"},     "Manage CPU breakpoints");
 
         {   VAMIGA_GROUP("")
@@ -504,6 +512,18 @@ DebugConsole::initCommands(Command &root)
 
                     dump(mem, Category::BankMap);
                 });
+
+                root.add({"i", "memory", "pages"},
+                         "Lists all pages modified since the last call",
+                         [this](Arguments& argv, long value) {
+
+                    {   SUSPENDED
+
+                        std::stringstream ss;
+                        mem.debugger.pageDump(ss);
+                        retroShell << ss;
+                    }
+                });
             }
 
             root.add({"i", "cpu"}, "Motorola CPU");
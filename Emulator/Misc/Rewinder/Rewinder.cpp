@@ -0,0 +1,732 @@
+// -----------------------------------------------------------------------------
+// This file is part of vAmiga
+//
+// Copyright (C) Dirk W. Hoffmann. www.dirkwhoffmann.de
+// Licensed under the Mozilla Public License v2
+//
+// See https://mozilla.org/MPL/2.0 for license information
+// -----------------------------------------------------------------------------
+
+#include "config.h"
+#include "Rewinder.h"
+#include "Amiga.h"
+#include "Compression.h"
+#include "IOUtils.h"
+#include <algorithm>
+
+namespace vamiga {
+
+// Size of a floppy disk track buffer
+static constexpr isize trackSize = 32768;
+
+// The memory types covered by the shadow copies
+static constexpr MemorySource memSources[6] = {
+
+    MEM_ROM, MEM_WOM, MEM_EXT, MEM_CHIP, MEM_SLOW, MEM_FAST
+};
+
+static u8 *
+memPtr(Memory &mem, isize unit)
+{
+    switch (memSources[unit]) {
+
+        case MEM_ROM:   return mem.rom;
+        case MEM_WOM:   return mem.wom;
+        case MEM_EXT:   return mem.ext;
+        case MEM_CHIP:  return mem.chip;
+        case MEM_SLOW:  return mem.slow;
+        case MEM_FAST:  return mem.fast;
+
+        default:
+            fatalError;
+    }
+}
+
+static isize
+memSize(const Memory &mem, isize unit)
+{
+    auto &config = mem.getConfig();
+
+    switch (memSources[unit]) {
+
+        case MEM_ROM:   return config.romSize;
+        case MEM_WOM:   return config.womSize;
+        case MEM_EXT:   return config.extSize;
+        case MEM_CHIP:  return config.chipSize;
+        case MEM_SLOW:  return config.slowSize;
+        case MEM_FAST:  return config.fastSize;
+
+        default:
+            fatalError;
+    }
+}
+
+void
+Rewinder::_dump(Category category, std::ostream& os) const
+{
+    using namespace util;
+
+    if (category == Category::State) {
+
+        isize keyframes = 0;
+        for (auto &frame : frames) if (frame.keyframe) keyframes++;
+
+        os << tab("Recorded frames");
+        os << dec(isize(frames.size())) << std::endl;
+        os << tab("Keyframes");
+        os << dec(keyframes) << std::endl;
+        os << tab("First frame");
+        os << (frames.empty() ? "-" : std::to_string(frames.front().nr)) << std::endl;
+        os << tab("Last frame");
+        os << (frames.empty() ? "-" : std::to_string(frames.back().nr)) << std::endl;
+        os << tab("Recording");
+        os << dec(usage) << " Bytes" << std::endl;
+        os << tab("Buffers");
+        os << dec(overhead()) << " Bytes" << std::endl;
+    }
+}
+
+void
+Rewinder::clear()
+{
+    frames.clear();
+    state.dealloc();
+    current.dealloc();
+    scratch.dealloc();
+
+    for (auto &shadow : memory) shadow.dealloc();
+    for (auto &shadow : disks) shadow = DiskShadow();
+    for (auto &shadow : drives) shadow = DriveShadow();
+
+    usage = 0;
+    forceKeyframe = false;
+}
+
+void
+Rewinder::record(Amiga &amiga, isize maxFrames, isize budget)
+{
+    // Start over if the media layout has changed
+    if (!frames.empty() && !matches(amiga)) clear();
+
+    auto size = stateSize(amiga);
+
+    if (frames.empty()) {
+
+        // Only start recording if the shadow copies and buffers fit in
+        if (shadowSize(amiga) + 3 * size + 2 * trackSize > budget) return;
+        initShadows(amiga);
+    }
+
+    // Serialize the component state
+    current.alloc(size);
+    saveState(amiga, current.ptr);
+
+    auto &frame = frames.emplace_back();
+    frame.nr = amiga.agnus.pos.frame;
+    frame.size = size;
+
+    // Decide whether a keyframe is needed
+    isize distance = 0;
+    for (auto it = frames.rbegin() + 1; it != frames.rend() && !it->keyframe; it++) distance++;
+    frame.keyframe =
+    forceKeyframe || frames.size() == 1 || state.size != size || distance + 1 >= keyframeDelay;
+
+    if (!frame.keyframe) {
+
+        // Store the difference to the previous frame
+        scratch.alloc(std::max(scratch.size, size / 4));
+        auto count = encode(state.ptr, current.ptr, size, scratch.ptr, size / 4);
+
+        if (count >= 0) {
+            frame.data.init(scratch.ptr, count);
+        } else {
+            frame.keyframe = true;
+        }
+    }
+
+    if (frame.keyframe) {
+
+        // Store the complete state
+        scratch.alloc(std::max(scratch.size, util::maxCompressedSize(size)));
+        auto count = util::compress(current.ptr, size, scratch.ptr);
+        frame.data.init(scratch.ptr, count);
+    }
+
+    // Store the differences of all modified pages, tracks, and blocks
+    recordBulk(amiga, frame);
+
+    usage += frame.data.size + frame.bulk.size;
+    forceKeyframe = false;
+
+    // Make the current state the reference for the next frame
+    std::swap(state.ptr, current.ptr);
+    std::swap(state.size, current.size);
+
+    trim(maxFrames, budget);
+
+    // Give up if the shadow copies have outgrown the budget
+    if (overhead() > budget) clear();
+}
+
+isize
+Rewinder::rewind(Amiga &amiga, isize count)
+{
+    count = std::min(count, available());
+    if (count <= 0) return 0;
+
+    // Stop here if the media layout has changed since the latest frame
+    if (!matches(amiga)) { clear(); return 0; }
+
+    auto newest = isize(frames.size()) - 1;
+    auto target = newest - count;
+
+    // Locate the keyframe at or before the target frame
+    auto key = target;
+    while (!frames[key].keyframe) key--;
+
+    // Check if the path from the most recent frame is free of keyframes
+    auto next = target + 1;
+    while (next <= newest && !frames[next].keyframe) next++;
+
+    if (next > newest && count <= target - key) {
+
+        // Walk backward, starting at the most recent state
+        current.init(state);
+        for (isize i = newest; i > target; i--) {
+            apply(frames[i].data.ptr, frames[i].data.size, current.ptr, current.size);
+        }
+
+    } else {
+
+        // Walk forward, starting at the keyframe
+        auto &frame = frames[key];
+        current.alloc(frame.size);
+
+        if (util::decompress(frame.data.ptr, frame.data.size, current.ptr, frame.size) != frame.size) {
+            throw Error(ERROR_SNAP_CORRUPTED);
+        }
+        for (isize i = key + 1; i <= target; i++) {
+            apply(frames[i].data.ptr, frames[i].data.size, current.ptr, current.size);
+        }
+    }
+
+    // Rewind the shadow copies of the bulk data
+    std::vector<std::tuple<Item, isize, isize>> items;
+    rewindBulk(amiga, newest, target, items);
+
+    // Save the current component state to be able to back out
+    auto size = stateSize(amiga);
+    scratch.alloc(std::max(scratch.size, size));
+    saveState(amiga, scratch.ptr);
+
+    try {
+
+        loadState(amiga, current.ptr);
+
+    } catch (...) {
+
+        loadState(amiga, scratch.ptr);
+        throw;
+    }
+
+    // Copy all affected pages, tracks, and blocks back into the emulator
+    restoreBulk(amiga, items);
+    syncStamps(amiga);
+
+    // Discard all frames following the target frame
+    while (isize(frames.size()) > target + 1) {
+
+        usage -= frames.back().data.size + frames.back().bulk.size;
+        frames.pop_back();
+    }
+
+    // Make the restored state the reference for the next frame
+    std::swap(state.ptr, current.ptr);
+    std::swap(state.size, current.size);
+
+    return count;
+}
+
+void
+Rewinder::trim(isize maxFrames, isize budget)
+{
+    while (isize(frames.size()) > maxFrames + 1 || footprint() > budget) {
+
+        // Find the beginning of the second segment
+        isize next = 1;
+        while (next < isize(frames.size()) && !frames[next].keyframe) next++;
+
+        // If there is only a single segment, request a new one
+        if (next == isize(frames.size())) { forceKeyframe = true; break; }
+
+        // Discard the oldest segment
+        for (isize i = 0; i < next; i++) {
+
+            usage -= frames.front().data.size + frames.front().bulk.size;
+            frames.pop_front();
+        }
+    }
+}
+
+isize
+Rewinder::overhead() const
+{
+    isize result = state.size + current.size + scratch.size;
+
+    for (auto &shadow : memory) result += shadow.size;
+    for (auto &shadow : disks) for (auto &track : shadow.tracks) result += track.size;
+    for (auto &shadow : drives) {
+
+        result += shadow.stamps.size * isizeof(u32);
+        result += shadow.data.size + 512 * isize(shadow.blocks.size());
+    }
+
+    return result;
+}
+
+isize
+Rewinder::encode(const u8 *a, const u8 *b, isize len, u8 *dst, isize capacity)
+{
+    u8 *out = dst;
+    isize i = 0, last = 0;
+
+    while (i < len) {
+
+        // Skip identical bytes
+        while (i + 256 <= len && std::memcmp(a + i, b + i, 256) == 0) i += 256;
+        for (u64 x, y; i + 8 <= len; i += 8) {
+
+            std::memcpy(&x, a + i, 8);
+            std::memcpy(&y, b + i, 8);
+            if (x != y) break;
+        }
+        while (i < len && a[i] == b[i]) i++;
+        if (i == len) break;
+
+        // Find the end of the modified area (tolerating short gaps)
+        isize end = i + 1;
+        for (isize k = end; k < len && k - end < 8; k++) if (a[k] != b[k]) end = k + 1;
+
+        // Emit a record (gap size, length, XOR values)
+        if (out + 8 + (end - i) > dst + capacity) return -1;
+
+        write32(out, u32(i - last));
+        write32(out, u32(end - i));
+        for (; i < end; i++) *out++ = a[i] ^ b[i];
+
+        last = end;
+    }
+
+    return isize(out - dst);
+}
+
+void
+Rewinder::apply(const u8 *delta, isize len, u8 *state, isize size)
+{
+    const u8 *src = delta;
+    const u8 *end = delta + len;
+    isize pos = 0;
+
+    while (src + 8 <= end) {
+
+        pos += read32(src);
+        isize count = read32(src);
+
+        if (pos + count > size || src + count > end) throw Error(ERROR_SNAP_CORRUPTED);
+        for (; count > 0; count--) state[pos++] ^= *src++;
+    }
+
+    if (src != end) throw Error(ERROR_SNAP_CORRUPTED);
+}
+
+isize
+Rewinder::stateSize(Amiga &amiga)
+{
+    isize result = 0;
+
+    amiga.postorderWalk([&result](CoreComponent *c) {
+
+        SerCounter counter(false); *c << counter;
+        result += counter.count;
+    });
+
+    return result;
+}
+
+void
+Rewinder::saveState(Amiga &amiga, u8 *buf)
+{
+    amiga.postorderWalk([&buf](CoreComponent *c) {
+
+        SerWriter writer(buf, false); *c << writer;
+        buf = writer.ptr;
+    });
+}
+
+void
+Rewinder::loadState(Amiga &amiga, const u8 *buf)
+{
+    amiga.postorderWalk([&buf](CoreComponent *c) {
+
+        SerReader reader(buf, false); *c << reader;
+        buf = reader.ptr;
+    });
+
+    amiga.postorderWalk([](CoreComponent *c) { c->_didLoad(); });
+}
+
+bool
+Rewinder::matches(Amiga &amiga) const
+{
+    for (isize i = 0; i < 6; i++) {
+
+        if (memory[i].size != memSize(amiga.mem, i)) return false;
+    }
+
+    for (isize i = 0; i < 4; i++) {
+
+        auto *disk = amiga.df[i]->disk.get();
+
+        if (disks[i].disk != disk) return false;
+        if (disk && disks[i].source != disk->source.get()) return false;
+    }
+
+    for (isize i = 0; i < 4; i++) {
+
+        auto &hd = *amiga.hd[i];
+
+        if (drives[i].image != hd.image.get()) return false;
+        if (drives[i].capacity != hd.geometry.numBytes()) return false;
+        if (drives[i].stamps.size != hd.stamps.size) return false;
+        if (!hd.image && drives[i].data.size != hd.data.size) return false;
+    }
+
+    return true;
+}
+
+isize
+Rewinder::shadowSize(Amiga &amiga) const
+{
+    isize result = 0;
+
+    for (isize i = 0; i < 6; i++) result += memSize(amiga.mem, i);
+
+    for (isize i = 0; i < 4; i++) {
+
+        if (auto *disk = amiga.df[i]->disk.get()) {
+
+            for (Track t = 0; t < disk->numTracks(); t++) {
+                if (!disk->pending[t]) result += trackSize;
+            }
+        }
+    }
+
+    for (isize i = 0; i < 4; i++) {
+
+        auto &hd = *amiga.hd[i];
+
+        result += hd.stamps.size * isizeof(u32);
+        result += hd.image ? 512 * isize(hd.overlay.size()) : hd.data.size;
+    }
+
+    return result;
+}
+
+void
+Rewinder::initShadows(Amiga &amiga)
+{
+    for (isize i = 0; i < 6; i++) {
+
+        auto size = memSize(amiga.mem, i);
+        if (size) memory[i].init(memPtr(amiga.mem, i), size); else memory[i].dealloc();
+    }
+
+    for (isize i = 0; i < 4; i++) {
+
+        auto &shadow = disks[i];
+        auto *disk = amiga.df[i]->disk.get();
+
+        shadow.disk = disk;
+        shadow.source = disk ? disk->source.get() : nullptr;
+
+        for (Track t = 0; t < 168; t++) {
+
+            // Tracks waiting to be encoded are copied when they get modified
+            if (disk && t < disk->numTracks() && !disk->pending[t]) {
+                shadow.tracks[t].init(disk->data.track[t], trackSize);
+            } else {
+                shadow.tracks[t].dealloc();
+            }
+        }
+    }
+
+    for (isize i = 0; i < 4; i++) {
+
+        auto &shadow = drives[i];
+        auto &hd = *amiga.hd[i];
+
+        shadow.image = hd.image.get();
+        shadow.capacity = hd.geometry.numBytes();
+
+        if (hd.image || hd.data.empty()) {
+
+            shadow.data.dealloc();
+            shadow.blocks = hd.overlay;
+
+        } else {
+
+            shadow.data.init(hd.data);
+            shadow.blocks.clear();
+        }
+
+        shadow.stamps.init(hd.stamps.size, 0);
+        shadow.stamp = 0;
+    }
+
+    syncStamps(amiga);
+}
+
+void
+Rewinder::syncStamps(Amiga &amiga)
+{
+    checkpoint = amiga.mem.checkpoint();
+
+    for (isize i = 0; i < 4; i++) {
+
+        if (auto *disk = amiga.df[i]->disk.get()) {
+            std::copy(std::begin(disk->stamp), std::end(disk->stamp), std::begin(disks[i].stamps));
+        }
+    }
+
+    for (isize i = 0; i < 4; i++) {
+
+        auto &shadow = drives[i];
+        auto &hd = *amiga.hd[i];
+
+        if (shadow.stamp != hd.stamp) {
+
+            std::copy(hd.stamps.ptr, hd.stamps.ptr + hd.stamps.size, shadow.stamps.ptr);
+            shadow.stamp = hd.stamp;
+        }
+    }
+}
+
+void
+Rewinder::forEachModified(Amiga &amiga,
+                          std::function<void(Item item, isize unit, isize nr)> func) const
+{
+    auto &mem = amiga.mem;
+
+    for (isize i = 0; i < 6; i++) {
+
+        for (isize p = 0, count = mem.numPages(memSources[i]); p < count; p++) {
+            if (mem.isModified(memSources[i], p, checkpoint)) func(Item::Page, i, p);
+        }
+    }
+
+    for (isize i = 0; i < 4; i++) {
+
+        if (auto *disk = amiga.df[i]->disk.get()) {
+
+            for (Track t = 0; t < disk->numTracks(); t++) {
+                if (disk->stamp[t] != disks[i].stamps[t]) func(Item::Track, i, t);
+            }
+        }
+    }
+
+    for (isize i = 0; i < 4; i++) {
+
+        auto &hd = *amiga.hd[i];
+
+        // Skip the block-wise comparison if the drive hasn't been written to
+        if (hd.stamp == drives[i].stamp) continue;
+
+        for (isize b = 0; b < hd.stamps.size; b++) {
+            if (hd.stamps[b] != drives[i].stamps[b]) func(Item::Block, i, b);
+        }
+    }
+}
+
+isize
+Rewinder::itemSize(Item item, isize unit, isize nr) const
+{
+    switch (item) {
+
+        case Item::Page:    return std::min(isize(MEM_PAGE_SIZE), memory[unit].size - nr * MEM_PAGE_SIZE);
+        case Item::Track:   return trackSize;
+        case Item::Block:   return 512;
+
+        default:
+            fatalError;
+    }
+}
+
+const u8 *
+Rewinder::itemPtr(Amiga &amiga, Item item, isize unit, isize nr) const
+{
+    switch (item) {
+
+        case Item::Page:    return memPtr(amiga.mem, unit) + nr * MEM_PAGE_SIZE;
+        case Item::Track:   return amiga.df[unit]->disk->data.track[nr];
+        case Item::Block:   return amiga.hd[unit]->blockPtr(nr);
+
+        default:
+            fatalError;
+    }
+}
+
+u8 *
+Rewinder::shadowPtr(Item item, isize unit, isize nr)
+{
+    switch (item) {
+
+        case Item::Page:
+
+            return memory[unit].ptr + nr * MEM_PAGE_SIZE;
+
+        case Item::Track:
+        {
+            // Tracks that were pending when the recording began start out empty
+            auto &track = disks[unit].tracks[nr];
+            if (track.empty()) track.init(trackSize, 0);
+            return track.ptr;
+        }
+        case Item::Block:
+        {
+            auto &shadow = drives[unit];
+            if (!shadow.image) return shadow.data.ptr + 512 * nr;
+
+            // Blocks which are not recorded match the mapped image
+            auto [it, inserted] = shadow.blocks.try_emplace(nr);
+            if (inserted) std::memcpy(it->second.data(), shadow.image + 512 * nr, 512);
+            return it->second.data();
+        }
+        default:
+            fatalError;
+    }
+}
+
+void
+Rewinder::recordBulk(Amiga &amiga, Frame &frame)
+{
+    std::vector<u8> records;
+
+    forEachModified(amiga, [&](Item item, isize unit, isize nr) {
+
+        auto len = itemSize(item, unit, nr);
+        auto src = itemPtr(amiga, item, unit, nr);
+        auto dst = shadowPtr(item, unit, nr);
+
+        // Encode the difference to the shadow copy
+        if (scratch.size < 2 * len) scratch.alloc(2 * len);
+        auto count = encode(dst, src, len, scratch.ptr, 2 * len);
+        assert(count >= 0);
+
+        if (count > 0) {
+
+            // Emit a record (item type, unit, item number, length, XOR values)
+            auto offset = records.size();
+            records.resize(offset + 10 + count);
+
+            u8 *p = records.data() + offset;
+            write8(p, u8(item));
+            write8(p, u8(unit));
+            write32(p, u32(nr));
+            write32(p, u32(count));
+            std::memcpy(p, scratch.ptr, count);
+
+            // Update the shadow copy
+            std::memcpy(dst, src, len);
+        }
+
+        // Only keep blocks differing from the mapped image
+        if (item == Item::Block && drives[unit].image) {
+            if (!std::memcmp(dst, drives[unit].image + 512 * nr, 512)) drives[unit].blocks.erase(nr);
+        }
+    });
+
+    if (!records.empty()) frame.bulk.init(records.data(), isize(records.size()));
+    syncStamps(amiga);
+}
+
+void
+Rewinder::rewindBulk(Amiga &amiga, isize newest, isize target,
+                     std::vector<std::tuple<Item, isize, isize>> &items)
+{
+    // Items modified after the latest frame need to be restored, too
+    forEachModified(amiga, [&](Item item, isize unit, isize nr) {
+        items.push_back({ item, unit, nr });
+    });
+
+    for (isize i = newest; i > target; i--) {
+
+        const u8 *p = frames[i].bulk.ptr;
+        const u8 *end = p + frames[i].bulk.size;
+
+        while (p < end) {
+
+            if (p + 10 > end) throw Error(ERROR_SNAP_CORRUPTED);
+
+            auto item = Item(read8(p));
+            isize unit = read8(p);
+            isize nr = read32(p);
+            isize count = read32(p);
+
+            // Check the integrity of the record
+            bool valid =
+            (item == Item::Page && unit < 6 && nr * MEM_PAGE_SIZE < memory[unit].size) ||
+            (item == Item::Track && unit < 4 && nr < 168 && disks[unit].disk) ||
+            (item == Item::Block && unit < 4 && nr < drives[unit].stamps.size);
+
+            if (!valid || p + count > end) throw Error(ERROR_SNAP_CORRUPTED);
+
+            // Turn the shadow copy into the previous version of the item
+            apply(p, count, shadowPtr(item, unit, nr), itemSize(item, unit, nr));
+            items.push_back({ item, unit, nr });
+            p += count;
+        }
+    }
+
+    // Restore each item only once
+    std::sort(items.begin(), items.end());
+    items.erase(std::unique(items.begin(), items.end()), items.end());
+}
+
+void
+Rewinder::restoreBulk(Amiga &amiga, const std::vector<std::tuple<Item, isize, isize>> &items)
+{
+    for (auto &[item, unit, nr] : items) {
+
+        switch (item) {
+
+            case Item::Page:
+
+                std::memcpy(memPtr(amiga.mem, unit) + nr * MEM_PAGE_SIZE,
+                            shadowPtr(item, unit, nr), itemSize(item, unit, nr));
+                amiga.mem.touchPage(memSources[unit], nr);
+                break;
+
+            case Item::Track:
+            {
+                auto *disk = amiga.df[unit]->disk.get();
+
+                // Skip tracks that have been pending throughout the recording
+                if (disks[unit].tracks[nr].empty()) break;
+
+                std::memcpy(disk->data.track[nr], disks[unit].tracks[nr].ptr, trackSize);
+                disk->touch(Track(nr));
+                break;
+            }
+            case Item::Block:
+
+                amiga.hd[unit]->importBlock(nr, shadowPtr(item, unit, nr));
+                amiga.hd[unit]->touch(512 * nr, 512);
+                break;
+
+            default:
+                fatalError;
+        }
+    }
+}
+
+}
@@ -0,0 +1,231 @@
+// -----------------------------------------------------------------------------
+// This file is part of vAmiga
+//
+// Copyright (C) Dirk W. Hoffmann. www.dirkwhoffmann.de
+// Licensed under the Mozilla Public License v2
+//
+// See https://mozilla.org/MPL/2.0 for license information
+// -----------------------------------------------------------------------------
+
+#pragma once
+
+#include "CoreObject.h"
+#include "Buffer.h"
+#include <array>
+#include <deque>
+#include <functional>
+#include <unordered_map>
+
+namespace vamiga {
+
+using util::Buffer;
+
+/* The rewinder records the most recent frames to let the user step back in
+ * time. Each frame is recorded in two parts.
+ *
+ * The first part is the component state, i.e., everything the components
+ * serialize except bulk data. The recording is organized as a sequence of
+ * segments. Each segment starts with a keyframe which stores the complete
+ * component state in compressed form. It is followed by delta frames which
+ * store the XOR difference to the preceding frame in run-length encoded form.
+ * Because XOR is its own inverse, deltas can be applied in both directions:
+ * Forward, starting at a keyframe, or backward, starting at the most recent
+ * state.
+ *
+ * The second part covers the bulk data, i.e., memory pages, floppy disk
+ * tracks, and hard drive blocks. The rewinder keeps shadow copies of this data
+ * as of the most recent frame and consults the modification stamps to find
+ * the items that have changed. For each of them, the XOR difference to the
+ * shadow copy is recorded. Bulk data is always restored backward, starting at
+ * the shadow copies. Tracks waiting to be MFM encoded are not copied, and for
+ * memory-mapped hard drives, only blocks differing from the image are kept.
+ *
+ * The recording starts over whenever the media layout changes, e.g., when a
+ * disk is inserted or the memory configuration is altered. When the recording
+ * exceeds its frame limit or its memory budget, the oldest segment is
+ * discarded. The budget covers the recorded frames, the shadow copies, and
+ * all working buffers.
+ */
+class Rewinder final : public CoreObject {
+
+    struct Frame {
+
+        // Frame number
+        i64 nr = 0;
+
+        // Indicates if this frame is a keyframe
+        bool keyframe = false;
+
+        // Size of the serialized component state
+        isize size = 0;
+
+        // Compressed state (keyframes) or encoded XOR delta (delta frames)
+        Buffer<u8> data;
+
+        // Encoded XOR deltas of all modified pages, tracks, and blocks
+        Buffer<u8> bulk;
+    };
+
+    // Bulk data items
+    enum class Item : u8 { Page, Track, Block };
+
+    // Shadow copy of an inserted floppy disk
+    struct DiskShadow {
+
+        // The recorded disk and the file it is lazily encoded from
+        const class FloppyDisk *disk = nullptr;
+        const class FloppyFile *source = nullptr;
+
+        // Track stamps as of the most recent frame
+        u64 stamps[168] = { };
+
+        // Track data (empty if a track was pending when the recording began)
+        Buffer<u8> tracks[168];
+    };
+
+    // Shadow copy of a hard drive
+    struct DriveShadow {
+
+        // The mapped image (if any) and the disk capacity
+        const u8 *image = nullptr;
+        isize capacity = 0;
+
+        // Block stamps as of the most recent frame
+        Buffer<u32> stamps;
+        u32 stamp = 0;
+
+        // Disk data (unmapped drives) or blocks differing from the image
+        Buffer<u8> data;
+        std::unordered_map<isize, std::array<u8, 512>> blocks;
+    };
+
+    // Maximum number of frames between two keyframes
+    static constexpr isize keyframeDelay = 50;
+
+    // The recorded frames (oldest first)
+    std::deque<Frame> frames;
+
+    // The most recently recorded component state
+    Buffer<u8> state;
+
+    // Working buffers
+    Buffer<u8> current;
+    Buffer<u8> scratch;
+
+    // Shadow copies of Rom, Wom, Extended Rom, Chip Ram, Slow Ram, Fast Ram
+    Buffer<u8> memory[6];
+
+    // The memory checkpoint taken at the most recent frame
+    u32 checkpoint = 0;
+
+    // Shadow copies of all floppy disks and hard drives
+    DiskShadow disks[4];
+    DriveShadow drives[4];
+
+    // Number of bytes occupied by the recorded frames
+    isize usage = 0;
+
+    // Indicates that the next recorded frame must be a keyframe
+    bool forceKeyframe = false;
+
+
+    //
+    // Methods from CoreObject
+    //
+
+public:
+
+    const char *objectName() const override { return "Rewinder"; }
+
+private:
+
+    void _dump(Category category, std::ostream& os) const override;
+
+
+    //
+    // Recording
+    //
+
+public:
+
+    // Returns the number of frames the emulator can step back
+    isize available() const { return frames.empty() ? 0 : isize(frames.size()) - 1; }
+
+    // Returns the number of bytes occupied by the recording and its buffers
+    isize footprint() const { return usage + overhead(); }
+
+    // Deletes the recording
+    void clear();
+
+    // Records the current state (called at the end of each frame)
+    void record(class Amiga &amiga, isize maxFrames, isize budget);
+
+    /* Restores an earlier state (returns the number of rewound frames). If an
+     * error is thrown, the emulator state remains unchanged.
+     */
+    isize rewind(class Amiga &amiga, isize count) throws;
+
+private:
+
+    // Discards the oldest segments until the recording fits the limits
+    void trim(isize maxFrames, isize budget);
+
+    // Returns the number of bytes occupied by the shadow copies and buffers
+    isize overhead() const;
+
+    // Encodes the XOR difference of two states (returns -1 if it doesn't fit)
+    static isize encode(const u8 *a, const u8 *b, isize len, u8 *dst, isize capacity);
+
+    // Applies an encoded XOR difference to a state
+    static void apply(const u8 *delta, isize len, u8 *state, isize size) throws;
+
+
+    //
+    // Serializing the component state
+    //
+
+    static isize stateSize(class Amiga &amiga);
+    static void saveState(class Amiga &amiga, u8 *buf);
+    static void loadState(class Amiga &amiga, const u8 *buf) throws;
+
+
+    //
+    // Tracking bulk data
+    //
+
+    // Checks if the media layout matches the shadow copies
+    bool matches(class Amiga &amiga) const;
+
+    // Returns the number of bytes the shadow copies will occupy initially
+    isize shadowSize(class Amiga &amiga) const;
+
+    // Creates the shadow copies
+    void initShadows(class Amiga &amiga);
+
+    // Updates the recorded stamps
+    void syncStamps(class Amiga &amiga);
+
+    // Calls a function for each item modified since the most recent frame
+    void forEachModified(class Amiga &amiga,
+                         std::function<void(Item item, isize unit, isize nr)> func) const;
+
+    // Returns the size of an item in bytes
+    isize itemSize(Item item, isize unit, isize nr) const;
+
+    // Returns a pointer to an item in the emulator or in the shadow copies
+    const u8 *itemPtr(class Amiga &amiga, Item item, isize unit, isize nr) const;
+    u8 *shadowPtr(Item item, isize unit, isize nr);
+
+    // Records the XOR differences of all modified items
+    void recordBulk(class Amiga &amiga, Frame &frame);
+
+    // Rewinds the shadow copies and collects the affected items
+    void rewindBulk(class Amiga &amiga, isize newest, isize target,
+                    std::vector<std::tuple<Item, isize, isize>> &items) throws;
+
+    // Copies items from the shadow copies back into the emulator
+    void restoreBulk(class Amiga &amiga,
+                     const std::vector<std::tuple<Item, isize, isize>> &items);
+};
+
+}
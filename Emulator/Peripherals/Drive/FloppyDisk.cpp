@@ -10,9 +10,14 @@
 #include "config.h"
 #include "FloppyDisk.h"
 #include "FloppyFile.h"
+#include "MemUtils.h"
+#include <algorithm>
+#include <array>
 
 namespace vamiga {
 
+std::atomic<u64> FloppyDisk::stampCounter = 0;
+
 void
 FloppyDisk::init(Diameter dia, Density den, bool wp)
 {
@@ -46,6 +51,7 @@ FloppyDisk::init(SerReader &reader, Diameter dia, Density den, bool wp)
 {
     init(dia, den, wp);
     serialize(reader);
+    touch();
 }
 
 FloppyDisk::~FloppyDisk()
@@ -53,6 +59,42 @@ FloppyDisk::~FloppyDisk()
     debug(OBJ_DEBUG, "Deleting disk\n");
 }
 
+FloppyDisk&
+FloppyDisk::operator= (const FloppyDisk& other) {
+
+    CLONE(diameter)
+    CLONE(density)
+    CLONE_ARRAY(length.track)
+    CLONE(flags)
+    CLONE(source)
+    CLONE_ARRAY(pending)
+
+    if (RUA_ON_STEROIDS) {
+
+        // Clone all tracks
+        CLONE_ARRAY(data.raw)
+        CLONE_ARRAY(stamp)
+        clonedBytes = sizeof(data.raw);
+
+    } else {
+
+        // Clone modified tracks
+        clonedBytes = 0;
+        for (Track t = 0; t < 168; t++) {
+
+            if (stamp[t] != other.stamp[t]) {
+
+                debug(RUA_DEBUG, "Cloning track %ld\n", t);
+                std::memcpy(data.track[t], other.data.track[t], sizeof(data.track[t]));
+                stamp[t] = other.stamp[t];
+                clonedBytes += sizeof(data.track[t]);
+            }
+        }
+    }
+
+    return *this;
+}
+
 void
 FloppyDisk::_dump(Category category, std::ostream& os) const
 {
@@ -103,7 +145,7 @@ FloppyDisk::isValidHeadPos(Cylinder c, Head h, isize offset) const
 }
 
 u64
-FloppyDisk::checksum() const
+FloppyDisk::checksum()
 {
     auto result = util::fnvInit64();
 
@@ -115,30 +157,33 @@ FloppyDisk::checksum() const
 }
 
 u64
-FloppyDisk::checksum(Track t) const
+FloppyDisk::checksum(Track t)
 {
+    encode(t);
     return util::fnv64(data.track[t], length.track[t]);
 }
 
 u64
-FloppyDisk::checksum(Cylinder c, Head h) const
+FloppyDisk::checksum(Cylinder c, Head h)
 {
     return checksum(c * numHeads() + h);
 }
 
 u8
-FloppyDisk::readBit(Track t, isize offset) const
+FloppyDisk::readBit(Track t, isize offset)
 {
     assert(isValidHeadPos(t, offset));
 
+    encode(t);
     return (data.track[t][offset / 8] & (0x80 >> (offset & 7))) != 0;
 }
 
 u8
-FloppyDisk::readBit(Cylinder c, Head h, isize offset) const
+FloppyDisk::readBit(Cylinder c, Head h, isize offset)
 {
     assert(isValidHeadPos(c, h, offset));
 
+    encode(2 * c + h);
     return (data.cylinder[c][h][offset / 8] & (0x80 >> (offset & 7))) != 0;
 }
 
@@ -147,11 +192,13 @@ FloppyDisk::writeBit(Track t, isize offset, bool value) {
 
     assert(isValidHeadPos(t, offset));
 
+    encode(t);
     if (value) {
         data.track[t][offset / 8] |= (0x0080 >> (offset & 7));
     } else {
         data.track[t][offset / 8] &= (0xFF7F >> (offset & 7));
     }
+    touch(t);
 }
 
 void
@@ -159,29 +206,33 @@ FloppyDisk::writeBit(Cylinder c, Head h, isize offset, bool value) {
 
     assert(isValidHeadPos(c, h, offset));
 
+    encode(2 * c + h);
     if (value) {
-        data.cylinder[h][c][offset / 8] |= (0x0080 >> (offset & 7));
+        data.cylinder[c][h][offset / 8] |= (0x0080 >> (offset & 7));
     } else {
-        data.cylinder[h][c][offset / 8] &= (0xFF7F >> (offset & 7));
+        data.cylinder[c][h][offset / 8] &= (0xFF7F >> (offset & 7));
     }
+    touch(2 * c + h);
 }
 
 u8
-FloppyDisk::readByte(Track t, isize offset) const
+FloppyDisk::readByte(Track t, isize offset)
 {
     assert(t < numTracks());
     assert(offset < length.track[t]);
 
+    encode(t);
     return data.track[t][offset];
 }
 
 u8
-FloppyDisk::readByte(Cylinder c, Head h, isize offset) const
+FloppyDisk::readByte(Cylinder c, Head h, isize offset)
 {
     assert(c < numCyls());
     assert(h < numHeads());
     assert(offset < length.cylinder[c][h]);
 
+    encode(2 * c + h);
     return data.cylinder[c][h][offset];
 }
 
@@ -191,7 +242,9 @@ FloppyDisk::writeByte(Track t, isize offset, u8 value)
     assert(t < numTracks());
     assert(offset < length.track[t]);
 
+    encode(t);
     data.track[t][offset] = value;
+    touch(t);
     setModified(true);
 }
 
@@ -202,20 +255,75 @@ FloppyDisk::writeByte(Cylinder c, Head h, isize offset, u8 value)
     assert(h < numHeads());
     assert(offset < length.cylinder[c][h]);
 
+    encode(2 * c + h);
     data.cylinder[c][h][offset] = value;
+    touch(2 * c + h);
     setModified(true);
 }
 
+isize
+FloppyDisk::nextSyncMark(Track t, isize offset)
+{
+    assert(t < numTracks());
+    assert(offset < length.track[t]);
+
+    encode(t);
+
+    // Rebuild the index if the track has been modified
+    if (syncStamp[t] != stamp[t]) {
+
+        auto *p = data.track[t];
+        isize len = length.track[t];
+
+        syncMarks[t].clear();
+        for (isize i = 0; i < len; i++) {
+
+            auto next = (u8 *)std::memchr(p + i, 0x44, size_t(len - i));
+            if (!next) break;
+
+            i = next - p;
+            if (p[(i + 1) % len] == 0x89) syncMarks[t].push_back(i32(i));
+        }
+        syncStamp[t] = stamp[t];
+    }
+
+    auto &marks = syncMarks[t];
+    if (marks.empty()) return -1;
+
+    // Continue at the beginning of the track if no mark is found behind offset
+    auto it = std::lower_bound(marks.begin(), marks.end(), offset);
+    return it != marks.end() ? *it : marks.front();
+}
+
+const u8 *
+FloppyDisk::noise()
+{
+    /* Unformatted disks are filled with pseudo-random data. Because the
+     * random number generator is always seeded with the same value, the
+     * pattern is computed once and copied afterwards.
+     */
+    static const std::vector<u8> pattern = [] {
+
+        std::vector<u8> result(sizeof(data.raw));
+
+        srand(0);
+        for (auto &byte : result) byte = rand() & 0xFF;
+        return result;
+    }();
+
+    return pattern.data();
+}
+
 void
 FloppyDisk::clearDisk()
 {
     setModified(FORCE_DISK_MODIFIED);
 
+    // Discard all tracks waiting to be encoded
+    discardPendingTracks();
+
     // Initialize with random data
-    srand(0);
-    for (isize i = 0; i < isizeof(data.raw); i++) {
-        data.raw[i] = rand() & 0xFF;
-    }
+    std::memcpy(data.raw, noise(), sizeof(data.raw));
     
     /* In order to make some copy protected game titles work, we smuggle in
      * some magic values. E.g., Crunch factory expects 0x44A2 on cylinder 80.
@@ -227,14 +335,19 @@ FloppyDisk::clearDisk()
             data.track[t][1] = 0xA2;
         }
     }
+
+    touch();
 }
 
 void
 FloppyDisk::clearDisk(u8 value)
 {
+    discardPendingTracks();
+
     for (isize i = 0; i < isizeof(data.raw); i++) {
         data.raw[i] = value;
     }
+    touch();
 }
 
 void
@@ -242,10 +355,9 @@ FloppyDisk::clearTrack(Track t)
 {
     assert(t < numTracks());
 
-    srand(0);
-    for (isize i = 0; i < length.track[t]; i++) {
-        data.track[t][i] = rand() & 0xFF;
-    }
+    pending[t] = false;
+    std::memcpy(data.track[t], noise(), length.track[t]);
+    touch(t);
 }
 
 void
@@ -253,9 +365,11 @@ FloppyDisk::clearTrack(Track t, u8 value)
 {
     assert(t < numTracks());
 
+    pending[t] = false;
     for (isize i = 0; i < isizeof(data.track[t]); i++) {
         data.track[t][i] = value;
     }
+    touch(t);
 }
 
 void
@@ -263,9 +377,11 @@ FloppyDisk::clearTrack(Track t, u8 value1, u8 value2)
 {
     assert(t < numTracks());
 
+    pending[t] = false;
     for (isize i = 0; i < length.track[t]; i++) {
         data.track[t][i] = IS_ODD(i) ? value2 : value1;
     }
+    touch(t);
 }
 
 void
@@ -278,6 +394,7 @@ FloppyDisk::encodeDisk(const FloppyFile &file)
 
     // Call the MFM encoder
     file.encodeDisk(*this);
+    touch();
 
     // Rectify the track alignment
 
@@ -298,11 +415,48 @@ FloppyDisk::encodeDisk(const FloppyFile &file)
     */
 }
 
+void
+FloppyDisk::encodeLazily(std::shared_ptr<const FloppyFile> file, isize n)
+{
+    assert(n <= 168);
+
+    source = file;
+    for (Track t = 0; t < n; t++) pending[t] = true;
+}
+
+void
+FloppyDisk::encodePendingTrack(Track t)
+{
+    assert(pending[t]);
+    assert(source);
+
+    debug(MFM_DEBUG, "Encoding track %ld on demand\n", t);
+
+    pending[t] = false;
+    source->encodeTrack(*this, t);
+}
+
+void
+FloppyDisk::encodePendingTracks()
+{
+    for (Track t = 0; t < 168; t++) encode(t);
+    source = nullptr;
+}
+
+void
+FloppyDisk::discardPendingTracks()
+{
+    for (Track t = 0; t < 168; t++) pending[t] = false;
+    source = nullptr;
+}
+
 void
 FloppyDisk::shiftTracks(isize offset)
 {
     debug(DSK_DEBUG, "Shifting tracks by %ld bytes against each other\n", offset);
 
+    encodePendingTracks();
+
     u8 spare[2 * 32768];
 
     for (Track t = 0; t < 168; t++) {
@@ -312,24 +466,32 @@ FloppyDisk::shiftTracks(isize offset)
         memcpy(spare, data.track[t], len);
         memcpy(spare + len, data.track[t], len);
         memcpy(data.track[t], spare + (len + t * offset) % len, len);
+        touch(t);
     }
 }
 
+/* Lookup table for the MFM encoder. It maps a data byte to an MFM word with
+ * the data bits stored at the even bit positions.
+ */
+static constexpr auto mfmSpread = []() {
+
+    std::array<u16, 256> result { };
+
+    for (isize i = 0; i < 256; i++) {
+        for (isize j = 0; j < 8; j++) {
+            if (i & (1 << j)) result[i] |= u16(1 << (2 * j));
+        }
+    }
+    return result;
+}();
+
 void
 FloppyDisk::encodeMFM(u8 *dst, u8 *src, isize count)
 {
     for(isize i = 0; i < count; i++) {
-        
-        auto mfm =
-        ((src[i] & 0b10000000) << 7) |
-        ((src[i] & 0b01000000) << 6) |
-        ((src[i] & 0b00100000) << 5) |
-        ((src[i] & 0b00010000) << 4) |
-        ((src[i] & 0b00001000) << 3) |
-        ((src[i] & 0b00000100) << 2) |
-        ((src[i] & 0b00000010) << 1) |
-        ((src[i] & 0b00000001) << 0);
-        
+
+        auto mfm = mfmSpread[src[i]];
+
         dst[2*i+0] = HI_BYTE(mfm);
         dst[2*i+1] = LO_BYTE(mfm);
     }
@@ -383,7 +545,26 @@ FloppyDisk::decodeOddEven(u8 *dst, u8 *src, isize count)
 void
 FloppyDisk::addClockBits(u8 *dst, isize count)
 {
-    for (isize i = 0; i < count; i++) {
+    /* The clock bits of a byte only depend on its own data bits and on the
+     * least significant data bit of the preceding byte. Because the data bits
+     * are not altered, eight bytes can be processed at once.
+     */
+    isize i = 0;
+
+    for (; i + 8 <= count; i += 8) {
+
+        u64 value;
+        std::memcpy(&value, dst + i, 8);
+        value = util::bigEndian(value) & 0x5555555555555555;
+
+        u64 previous = dst[i - 1] & 1;
+        u64 cBits = ~(value << 1 | value >> 1 | previous << 63) & 0xAAAAAAAAAAAAAAAA;
+
+        value = util::bigEndian(value | cBits);
+        std::memcpy(dst + i, &value, 8);
+    }
+
+    for (; i < count; i++) {
         dst[i] = addClockBits(dst[i], dst[i-1]);
     }
 }
@@ -409,20 +590,34 @@ FloppyDisk::addClockBits(u8 value, u8 previous)
 void
 FloppyDisk::repeatTracks()
 {
+    encodePendingTracks();
+
     for (Track t = 0; t < 168; t++) {
         
         isize end = length.track[t];
+        bool changed = false;
+
         for (isize i = end, j = 0; i < isizeof(data.track[t]); i++, j++) {
-            data.track[t][i] = data.track[t][j];
+
+            if (data.track[t][i] != data.track[t][j]) {
+
+                data.track[t][i] = data.track[t][j];
+                changed = true;
+            }
         }
+
+        // Only stamp tracks whose contents have actually changed
+        if (changed) touch(t);
     }
 }
 
 string
-FloppyDisk::readTrackBits(Track t) const
+FloppyDisk::readTrackBits(Track t)
 {
     assert(t < numTracks());
 
+    encode(t);
+
     string result;
     result.reserve(length.track[t]);
 
@@ -436,7 +631,7 @@ FloppyDisk::readTrackBits(Track t) const
 }
 
 string
-FloppyDisk::readTrackBits(Cylinder c, Head h) const
+FloppyDisk::readTrackBits(Cylinder c, Head h)
 {
     return readTrackBits(2 * c + h);
 }
@@ -59,6 +59,7 @@ class FloppyDisk : public CoreObject {
     friend class EADFFile;
     friend class IMGFile;
     friend class STFile;
+    friend class Rewinder;
 
 public:
     
@@ -85,7 +86,36 @@ private:
 
     // Disk state
     DiskFlags flags = 0;
-    
+
+    /* Modification stamps. Whenever a track is modified, it is assigned a
+     * new, globally unique stamp. When a disk is cloned, only those tracks
+     * are copied whose stamps differ from the stamps of the source disk.
+     */
+    u64 stamp[168] = { };
+
+    // Stamp counter (shared by all disks)
+    static std::atomic<u64> stampCounter;
+
+    /* Lazy encoding. When a disk is created from a disk file, the tracks are
+     * not MFM encoded right away. Instead, the disk keeps a copy of the file
+     * and encodes a track the first time it is accessed.
+     */
+    std::shared_ptr<const FloppyFile> source;
+
+    // Indicates which tracks still need to be encoded
+    bool pending[168] = { };
+
+    /* Sync mark index. For each track, the offsets of all sync marks (0x44
+     * followed by 0x89) are kept in a sorted list. The list is built on demand
+     * and remembers the stamp of the track it was built from. Since all write
+     * accessors assign a new stamp, the list is rebuilt automatically after a
+     * track has been modified.
+     */
+    std::vector<i32> syncMarks[168];
+    u64 syncStamp[168] = { };
+
+    // Number of bytes copied by the latest clone
+    isize clonedBytes = 0;
     
     //
     // Initializing
@@ -109,16 +139,7 @@ private:
     
 public:
 
-    FloppyDisk& operator= (const FloppyDisk& other) {
-
-        CLONE(diameter)
-        CLONE(density)
-        CLONE_ARRAY(data.raw)
-        CLONE_ARRAY(length.track)
-        CLONE(flags)
-
-        return *this;
-    }
+    FloppyDisk& operator= (const FloppyDisk& other);
 
 
     //
@@ -142,6 +163,23 @@ private:
     {
         if (isResetter(worker)) return;
 
+        if (skipsBulkData(worker)) {
+
+            // Skip the track data (the rewinder tracks it by stamp)
+            worker
+
+            << diameter
+            << density
+            << length.track
+            << flags
+            << pending;
+
+            return;
+        }
+
+        // Make sure that all tracks are MFM encoded
+        encodePendingTracks();
+
         worker
 
         << diameter
@@ -162,9 +200,13 @@ private:
     bool isValidHeadPos(Cylinder c, Head h, isize offset) const;
 
     // Computes a debug checksum for a single track or the entire disk
-    u64 checksum() const;
-    u64 checksum(Track t) const;
-    u64 checksum(Cylinder c, Head h) const;
+    u64 checksum();
+    u64 checksum(Track t);
+    u64 checksum(Cylinder c, Head h);
+
+    // Assigns a new modification stamp to a single track or all tracks
+    void touch(Track t) { stamp[t] = ++stampCounter; }
+    void touch() { for (Track t = 0; t < 168; t++) touch(t); }
 
 
     //
@@ -191,32 +233,43 @@ public:
     void setFlag(DiskFlags flag) { setFlag(flag, true); }
     void clearFlag(DiskFlags flag) { setFlag(flag, false); }
 
+    // Returns the number of bytes copied by the latest clone
+    isize getClonedBytes() const { return clonedBytes; }
+
     
     //
     // Reading and writing
     //
 
     // Reads a bit from disk
-    u8 readBit(Track t, isize offset) const;
-    u8 readBit(Cylinder c, Head h, isize offset) const;
+    u8 readBit(Track t, isize offset);
+    u8 readBit(Cylinder c, Head h, isize offset);
 
     // Writes a bit to disk
     void writeBit(Track t, isize offset, bool value);
     void writeBit(Cylinder c, Head h, isize offset, bool value);
 
     // Reads a byte from disk
-    u8 readByte(Track t, isize offset) const;
-    u8 readByte(Cylinder c, Head h, isize offset) const;
+    u8 readByte(Track t, isize offset);
+    u8 readByte(Cylinder c, Head h, isize offset);
     
     // Writes a byte to disk
     void writeByte(Track t, isize offset, u8 value);
     void writeByte(Cylinder c, Head h, isize offset, u8 value);
+
+    // Returns the first sync mark at or after an offset (wraps, -1 if none)
+    isize nextSyncMark(Track t, isize offset);
     
     
     //
     // Erasing
     //
     
+private:
+
+    // Returns the pseudo-random pattern of an unformatted disk
+    static const u8 *noise();
+
 public:
     
     // Initializes the disk with random data
@@ -240,6 +293,22 @@ public:
     // Encodes a disk
     void encodeDisk(const class FloppyFile &file);
 
+    // Defers encoding the first n tracks until they are accessed
+    void encodeLazily(std::shared_ptr<const FloppyFile> file, isize n);
+
+    // Encodes a track if this hasn't been done yet
+    void encode(Track t) { if (pending[t]) encodePendingTrack(t); }
+
+    // Encodes all tracks that haven't been encoded yet
+    void encodePendingTracks();
+
+private:
+
+    void encodePendingTrack(Track t);
+    void discardPendingTracks();
+
+public:
+
     // Shifts the tracks agains each other
     void shiftTracks(isize offset);
 
@@ -263,8 +332,8 @@ public:
     void repeatTracks();
     
     // Returns a textual representation of all bits of a track
-    string readTrackBits(Track t) const;
-    string readTrackBits(Cylinder c, Head h) const;
+    string readTrackBits(Track t);
+    string readTrackBits(Cylinder c, Head h);
 };
 
 }
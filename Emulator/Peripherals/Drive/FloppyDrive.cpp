@@ -368,7 +368,17 @@ FloppyDrive::operator << (SerReader &worker)
         Diameter type;
         Density density;
         worker << type << density;
-        disk = std::make_unique<FloppyDisk>(worker, type, density);
+
+        if (skipsBulkData(worker)) {
+
+            // Keep the inserted disk and restore its state only
+            if (!hasDisk()) throw Error(ERROR_SNAP_CORRUPTED);
+            disk->serialize(worker);
+
+        } else {
+
+            disk = std::make_unique<FloppyDisk>(worker, type, density);
+        }
 
     } else {
 
@@ -686,7 +696,7 @@ FloppyDrive::selectSide(Head h)
 }
 
 u8
-FloppyDrive::readByte() const
+FloppyDrive::readByte()
 {
     // Case 1: No disk is inserted
     if (!disk) return 0xFF;
@@ -737,6 +747,73 @@ FloppyDrive::writeWordAndRotate(u16 value)
     writeByteAndRotate(LO_BYTE(value));
 }
 
+void
+FloppyDrive::readBlockAndRotate(u8 *buffer, isize count)
+{
+    // Take the slow path if the data is not read from a spinning disk
+    if (!disk || !motor || agnus.clock < latestStepCompleted) {
+
+        for (isize i = 0; i < count; i++) buffer[i] = readByteAndRotate();
+        return;
+    }
+
+    Track t = 2 * head.cylinder + head.head;
+    isize length = disk->length.track[t];
+    assert(head.offset < length);
+    disk->encode(t);
+
+    while (count) {
+
+        // Copy all bytes up to the end of the track
+        isize n = std::min(count, length - head.offset);
+        std::memcpy(buffer, &disk->data.track[t][head.offset], n);
+        buffer += n;
+        count -= n;
+
+        // Emulate the rotations
+        if ((head.offset += n) >= length) {
+
+            head.offset = 0;
+            if (isSelected()) ciab.emulateFallingEdgeOnFlagPin();
+        }
+    }
+}
+
+void
+FloppyDrive::writeBlockAndRotate(const u8 *buffer, isize count)
+{
+    // Take the slow path if the data is not written to a spinning disk
+    if (!disk || !motor) {
+
+        for (isize i = 0; i < count; i++) writeByteAndRotate(buffer[i]);
+        return;
+    }
+
+    Track t = 2 * head.cylinder + head.head;
+    isize length = disk->length.track[t];
+    assert(head.offset < length);
+    disk->encode(t);
+
+    while (count) {
+
+        // Copy all bytes up to the end of the track
+        isize n = std::min(count, length - head.offset);
+        std::memcpy(&disk->data.track[t][head.offset], buffer, n);
+        buffer += n;
+        count -= n;
+
+        // Emulate the rotations
+        if ((head.offset += n) >= length) {
+
+            head.offset = 0;
+            if (isSelected()) ciab.emulateFallingEdgeOnFlagPin();
+        }
+    }
+
+    disk->touch(t);
+    disk->setModified(true);
+}
+
 void
 FloppyDrive::rotate()
 {
@@ -756,6 +833,46 @@ FloppyDrive::rotate()
 void
 FloppyDrive::findSyncMark()
 {
+    // Consult the sync mark index if the disk spins normally
+    if (disk && motor && agnus.clock >= latestStepCompleted) {
+
+        Track t = 2 * head.cylinder + head.head;
+        isize length = disk->length.track[t];
+        isize start = head.offset;
+
+        /* The scan below reads bytes in pairs if the first byte equals 0x44.
+         * Hence, a sync mark is only seen if it is preceded by an even number
+         * of 0x44 bytes. Marks skipped over that way are ignored here, too.
+         */
+        for (isize pos = start, dist = 0;;) {
+
+            auto mark = disk->nextSyncMark(t, pos);
+            if (mark < 0) break;
+
+            dist += (mark - pos + length) % length;
+            if (dist + 2 > length) break;
+
+            isize run = 1;
+            while (run <= dist && disk->data.track[t][(mark - run + length) % length] == 0x44) run++;
+
+            if (run % 2) {
+
+                // Move the drive head behind the sync mark
+                if ((head.offset = start + dist + 2) >= length) {
+
+                    head.offset -= length;
+                    if (isSelected()) ciab.emulateFallingEdgeOnFlagPin();
+                }
+
+                trace(DSK_DEBUG, "Moving to SYNC mark at offset %ld\n", head.offset);
+                return;
+            }
+
+            pos = (mark + 1) % length;
+            dist += 1;
+        }
+    }
+
     long length = disk->length.cylinder[head.cylinder][head.head];
     for (isize i = 0; i < length; i++) {
         
@@ -321,7 +321,7 @@ public:
     void selectSide(Head h);
 
     // Reads a value from the drive head and optionally rotates the disk
-    u8 readByte() const;
+    u8 readByte();
     u8 readByteAndRotate();
     u16 readWordAndRotate();
 
@@ -330,6 +330,10 @@ public:
     void writeByteAndRotate(u8 value);
     void writeWordAndRotate(u16 value);
 
+    // Transfers a block of bytes and rotates the disk (used in turbo mode)
+    void readBlockAndRotate(u8 *buffer, isize count);
+    void writeBlockAndRotate(const u8 *buffer, isize count);
+
     // Emulate a disk rotation (moves head to the next byte)
     void rotate();
 
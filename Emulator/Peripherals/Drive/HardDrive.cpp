@@ -14,10 +14,17 @@
 #include "IOUtils.h"
 #include "Memory.h"
 #include "MsgQueue.h"
+#ifndef _WIN32
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
 
 namespace vamiga {
 
 std::fstream HardDrive::wtStream[4];
+std::atomic<u32> HardDrive::stampCounter = 0;
 
 HardDrive::HardDrive(Amiga& ref, isize nr) : Drive(ref, nr)
 {
@@ -48,23 +55,51 @@ HardDrive::operator= (const HardDrive& other) {
     CLONE(flags)
     CLONE(bootable)
 
-    if (RUA_ON_STEROIDS) {
+    if (RUA_ON_STEROIDS || data.size != other.data.size || image != other.image) {
 
         // Clone all blocks
         CLONE(data)
+        CLONE(image)
+        CLONE(imageSize)
+        CLONE(imagePath)
+        CLONE(imageStamp)
+        CLONE(overlay)
+        CLONE(stamps)
+        CLONE(stamp)
+        clonedBytes = data.size + 512 * isize(overlay.size());
 
-    } else {
+    } else if (stamp != other.stamp) {
 
-        // Clone dirty blocks
-        data.resize(other.data.size);
-        for (isize i = 0; i < other.dirty.size; i++) {
+        // Clone modified blocks
+        clonedBytes = 0;
+        for (isize i = 0; i < other.stamps.size; i++) {
 
-            if (other.dirty[i]) {
+            if (stamps[i] != other.stamps[i]) {
 
                 debug(RUA_DEBUG, "Cloning block %ld\n", i);
-                memcpy(data.ptr + 512 * i, other.data.ptr + 512 * i, 512);
+
+                if (!image) {
+
+                    memcpy(data.ptr + 512 * i, other.data.ptr + 512 * i, 512);
+
+                } else if (auto it = other.overlay.find(i); it != other.overlay.end()) {
+
+                    overlay[i] = it->second;
+
+                } else {
+
+                    overlay.erase(i);
+                }
+                stamps[i] = other.stamps[i];
+                clonedBytes += 512;
             }
         }
+        stamp = other.stamp;
+
+    } else {
+
+        // Both drives are unmodified since the latest clone
+        clonedBytes = 0;
     }
 
     return *this;
@@ -74,7 +109,13 @@ void
 HardDrive::init()
 {
     data.dealloc();
-    dirty.dealloc();
+    image = nullptr;
+    imageSize = 0;
+    imagePath.clear();
+    imageStamp = { };
+    overlay.clear();
+    stamps.dealloc();
+    stamp = ++stampCounter;
 
     diskVendor = "VAMIGA";
     diskProduct = "VDRIVE";
@@ -92,6 +133,14 @@ HardDrive::init()
 void
 HardDrive::init(const GeometryDescriptor &geometry)
 {
+    init(geometry, nullptr, 0);
+}
+
+void
+HardDrive::init(const GeometryDescriptor &geometry, std::shared_ptr<const u8> mapping, isize size)
+{
+    assert(!mapping || size == geometry.numBytes());
+
     // Throw an exception if the geometry is not supported
     geometry.checkCompatibility();
     
@@ -103,8 +152,17 @@ HardDrive::init(const GeometryDescriptor &geometry)
     ptable.push_back(PartitionDescriptor(geometry));
 
     // Create the new drive
-    data.resize(geometry.numBytes());
-    dirty.resize(geometry.numBytes() / 512, true);
+    if (mapping) {
+
+        image = mapping;
+        imageSize = size;
+
+    } else {
+
+        data.resize(geometry.numBytes());
+    }
+    stamps.resize(geometry.numBytes() / 512);
+    touch();
 }
 
 void
@@ -123,6 +181,7 @@ HardDrive::init(const MutableFileSystem &fs)
     
     // Copy over all blocks
     fs.exportVolume(data.ptr, geometry.numBytes());
+    touch();
 }
 
 void 
@@ -141,11 +200,17 @@ HardDrive::init(const MediaFile &file)
 
 void
 HardDrive::init(const HDFFile &hdf)
+{
+    init(hdf, nullptr, 0);
+}
+
+void
+HardDrive::init(const HDFFile &hdf, std::shared_ptr<const u8> mapping, isize size)
 {
     auto geometry = hdf.getGeometry();
 
     // Create the drive
-    init(geometry);
+    init(geometry, mapping, size);
 
     // Copy the product description (if provided by the HDF)
     if (auto value = hdf.getDiskProduct(); value) diskProduct = *value;
@@ -176,23 +241,27 @@ HardDrive::init(const HDFFile &hdf)
         if (needed) { drivers.push_back(driver); }
     }
     
-    // Check the drive geometry against the file size
-    auto numBytes = hdf.data.size;
-    
-    if (data.size < numBytes) {
-        
-        debug(HDR_DEBUG, "HDF is too large. Ignoring excess bytes.\n");
-        numBytes = data.size;
-    }
-    if (data.size > hdf.data.size) {
-        
-        debug(HDR_DEBUG, "HDF is too small. Padding with zeroes.");
-        data.clear(0, hdf.data.size);
+    if (!image) {
+
+        // Check the drive geometry against the file size
+        auto numBytes = hdf.data.size;
+
+        if (data.size < numBytes) {
+
+            debug(HDR_DEBUG, "HDF is too large. Ignoring excess bytes.\n");
+            numBytes = data.size;
+        }
+        if (data.size > hdf.data.size) {
+
+            debug(HDR_DEBUG, "HDF is too small. Padding with zeroes.");
+            data.clear(0, hdf.data.size);
+        }
+
+        // Copy over all blocks
+        hdf.flash(data.ptr, 0, numBytes);
+        touch();
     }
     
-    // Copy over all blocks
-    hdf.flash(data.ptr, 0, numBytes);
-    
     // Replace the write-through image on disk
     if (config.writeThrough) {
 
@@ -213,6 +282,26 @@ HardDrive::init(const HDFFile &hdf)
 void
 HardDrive::init(const std::filesystem::path &path) throws
 {
+    auto size = util::getSizeOfFile(path);
+
+    // Try to access the file directly instead of loading it into memory
+    FileStamp stamp;
+    if (auto mapping = mapFile(path, size, stamp); mapping) {
+
+        HDFFile hdf;
+        hdf.initView(mapping.get(), size);
+
+        // Only use the mapping if the file matches the drive geometry exactly
+        if (hdf.getGeometry().numBytes() == size) {
+
+            debug(HDR_DEBUG, "Mapped %ld bytes from %s\n", size, path.c_str());
+            init(hdf, mapping, size);
+            imagePath = path;
+            imageStamp = stamp;
+            return;
+        }
+    }
+
     HDFFile hdf(path);
     init(hdf);
 }
@@ -231,8 +320,7 @@ HardDrive::_initialize()
 
         try {
 
-            auto hdf = HDFFile(path);
-            init(hdf);
+            init(std::filesystem::path(path));
 
         } catch (...) {
 
@@ -245,9 +333,6 @@ void
 HardDrive::_didReset(bool hard)
 {
     if (FORCE_HDR_MODIFIED) { setFlag(FLAG_MODIFIED, true); }
-
-    // Mark all blocks as dirty
-    dirty.clear(true);
 }
 
 i64
@@ -417,8 +502,9 @@ HardDrive::_didLoad()
 {
     disableWriteThrough();
 
-    // Mark all blocks as dirty
-    dirty.clear(true);
+    // Mark all blocks as modified
+    stamps.resize(geometry.numBytes() / 512);
+    touch();
 }
 
 void
@@ -511,7 +597,7 @@ HardDrive::isConnected() const
 bool
 HardDrive::hasDisk() const
 {
-    return data.ptr != nullptr;
+    return data.ptr != nullptr || image != nullptr;
 }
 
 bool 
@@ -634,7 +720,7 @@ HardDrive::format(FSVolumeType fsType, string name)
     }
     
     // Only proceed if a disk is present
-    if (!data.ptr) return;
+    if (!hasDisk()) return;
 
     if (fsType != FS_NODOS) {
         
@@ -647,8 +733,26 @@ HardDrive::format(FSVolumeType fsType, string name)
         // Add name and bootblock
         fs.setName(name);
 
+        // The file system must cover the entire drive
+        if (fs.numBlocks() * 512 != geometry.numBytes()) throw Error(ERROR_FS_WRONG_CAPACITY);
+
         // Copy all blocks over
-        fs.exportVolume(data.ptr, geometry.numBytes());
+        if (!image) {
+
+            fs.exportVolume(data.ptr, geometry.numBytes());
+
+        } else {
+
+            u8 block[512];
+
+            overlay.clear();
+            for (isize nr = 0; nr < fs.numBlocks(); nr++) {
+
+                fs.exportBlock(Block(nr), block, 512);
+                importBlock(nr, block);
+            }
+        }
+        touch();
     }
 }
 
@@ -679,6 +783,9 @@ HardDrive::read(isize offset, isize length, u32 addr)
 {
     debug(HDR_DEBUG, "read(%ld, %ld, %u)\n", offset, length, addr);
 
+    // Make sure the mapped file is still intact
+    validateImage();
+
     // Check arguments
     auto error = verify(offset, length, addr);
     
@@ -690,7 +797,9 @@ HardDrive::read(isize offset, isize length, u32 addr)
         moveHead(offset / geometry.bsize);
 
         // Perform the read operation
-        mem.patch(addr, data.ptr + offset, length);
+        for (isize i = 0; i < length; i += 512) {
+            mem.patch(u32(addr + i), blockPtr((offset + i) / 512), 512);
+        }
 
         // Inform the GUI
         msgQueue.put(MSG_HDR_READ);
@@ -707,6 +816,9 @@ HardDrive::write(isize offset, isize length, u32 addr)
 {
     debug(HDR_DEBUG, "write(%ld, %ld, %u)\n", offset, length, addr);
 
+    // Make sure the mapped file is still intact
+    validateImage();
+
     // Check arguments
     auto error = verify(offset, length, addr);
     
@@ -720,13 +832,18 @@ HardDrive::write(isize offset, isize length, u32 addr)
         if (!getFlag(FLAG_PROTECTED)) {
 
             // Perform the write operation
-            mem.spypeek <ACCESSOR_CPU> (addr, length, data.ptr + offset);
+            for (isize i = 0; i < length; i += 512) {
+                mem.spypeek <ACCESSOR_CPU> (u32(addr + i), 512, writableBlockPtr((offset + i) / 512));
+            }
+            touch(offset, length);
             
             // Handle write-through mode
             if (config.writeThrough) {
                 
                 wtStream[objid].seekp(offset);
-                wtStream[objid].write((char *)(data.ptr + offset), length);
+                for (isize i = 0; i < length; i += 512) {
+                    wtStream[objid].write((char *)blockPtr((offset + i) / 512), 512);
+                }
             }
             
             setFlag(FLAG_PROTECTED, true);
@@ -758,17 +875,118 @@ HardDrive::readDriver(isize nr, Buffer<u8> &driver)
         auto offset = isize(seg * geometry.bsize + 20);
 
         assert(offset >= 0);
-        assert(offset + bytesPerBlock <= data.size);
+        assert(offset + bytesPerBlock <= geometry.numBytes());
         
-        memcpy(driver.ptr + bytesRead, data.ptr + offset, bytesPerBlock);
+        copy(driver.ptr + bytesRead, offset, bytesPerBlock);
         bytesRead += bytesPerBlock;
     }
 }
 
+void
+HardDrive::copy(u8 *buf, isize offset, isize len) const
+{
+    assert(offset >= 0 && offset + len <= geometry.numBytes());
+
+    if (!image) {
+
+        std::memcpy(buf, data.ptr + offset, len);
+        return;
+    }
+
+    while (len > 0) {
+
+        // Copy the remaining part of the current block
+        isize n = std::min(len, 512 - offset % 512);
+        std::memcpy(buf, blockPtr(offset / 512) + offset % 512, n);
+
+        buf += n;
+        offset += n;
+        len -= n;
+    }
+}
+
+u64
+HardDrive::fnv64() const
+{
+    if (!image) return data.fnv64();
+
+    u64 hash = util::fnvInit64();
+
+    for (isize nr = 0; nr < geometry.numBytes() / 512; nr++) {
+
+        auto *p = blockPtr(nr);
+        for (isize i = 0; i < 512; i++) hash = util::fnvIt64(hash, p[i]);
+    }
+
+    return hash;
+}
+
+const u8 *
+HardDrive::blockPtr(isize nr) const
+{
+    if (!image) return data.ptr + 512 * nr;
+
+    // Modified blocks are taken from the overlay
+    if (auto it = overlay.find(nr); it != overlay.end()) return it->second.data();
+
+    return image.get() + 512 * nr;
+}
+
+u8 *
+HardDrive::writableBlockPtr(isize nr)
+{
+    if (!image) return data.ptr + 512 * nr;
+
+    // Copy the block into the overlay when it is written for the first time
+    auto [it, inserted] = overlay.try_emplace(nr);
+    if (inserted) std::memcpy(it->second.data(), image.get() + 512 * nr, 512);
+
+    return it->second.data();
+}
+
+void
+HardDrive::importBlock(isize nr, const u8 *src)
+{
+    if (!image) {
+
+        std::memcpy(data.ptr + 512 * nr, src, 512);
+
+    } else if (std::memcmp(src, image.get() + 512 * nr, 512)) {
+
+        std::memcpy(overlay[nr].data(), src, 512);
+
+    } else {
+
+        overlay.erase(nr);
+    }
+}
+
+void
+HardDrive::restoreImage(const u8 *src, isize len)
+{
+    assert(image);
+
+    if (len == imageSize) {
+
+        overlay.clear();
+        for (isize nr = 0; nr < len / 512; nr++) importBlock(nr, src + 512 * nr);
+
+    } else {
+
+        // The snapshot doesn't match the mapped file
+        image = nullptr;
+        imageSize = 0;
+        imagePath.clear();
+        imageStamp = { };
+        overlay.clear();
+        data.init(src, len);
+    }
+}
+
 i8
 HardDrive::verify(isize offset, isize length, u32 addr)
 {
-    assert(data.ptr);
+    assert(hasDisk());
 
     if (length % 512) {
         
@@ -823,16 +1041,148 @@ HardDrive::moveHead(isize c, isize h, isize s)
     }
 }
 
+void
+HardDrive::touch(isize offset, isize length)
+{
+    if (length <= 0) return;
+
+    auto first = offset / 512;
+    auto last = std::min((offset + length - 1) / 512, stamps.size - 1);
+
+    for (isize i = first; i <= last; i++) stamps[i] = ++stampCounter;
+    stamp = stamps[last];
+}
+
 void
 HardDrive::writeToFile(const std::filesystem::path &path) throws
 {
     if (!path.empty()) {
 
+        validateImage();
         auto hdf = HDFFile(*this);
         hdf.writeToFile(path);
     }
 }
 
+#ifndef _WIN32
+
+// Reads the size, the modification time, and the inode number of a file
+static bool
+getFileStamp(const struct stat &st, isize &size, i64 &mtime, u64 &inode)
+{
+    if (!S_ISREG(st.st_mode)) return false;
+
+#ifdef __APPLE__
+    mtime = i64(st.st_mtimespec.tv_sec) * 1000000000 + st.st_mtimespec.tv_nsec;
+#else
+    mtime = i64(st.st_mtim.tv_sec) * 1000000000 + st.st_mtim.tv_nsec;
+#endif
+    size = isize(st.st_size);
+    inode = u64(st.st_ino);
+    return true;
+}
+
+#endif
+
+std::shared_ptr<const u8>
+HardDrive::mapFile(const std::filesystem::path &path, isize size, FileStamp &stamp)
+{
+#ifdef _WIN32
+
+    return nullptr;
+
+#else
+
+    if (size <= 0) return nullptr;
+
+    auto fd = ::open(path.c_str(), O_RDONLY);
+    if (fd == -1) return nullptr;
+
+    // Record the identity of the file to detect external modifications
+    struct stat st;
+    if (::fstat(fd, &st) != 0 ||
+        !getFileStamp(st, stamp.size, stamp.mtime, stamp.inode) || stamp.size != size) {
+
+        ::close(fd);
+        return nullptr;
+    }
+
+    auto ptr = ::mmap(nullptr, size_t(size), PROT_READ, MAP_PRIVATE, fd, 0);
+    ::close(fd);
+    if (ptr == MAP_FAILED) return nullptr;
+
+    return std::shared_ptr<const u8>((const u8 *)ptr, [size](const u8 *p) {
+        ::munmap((void *)p, size_t(size));
+    });
+
+#endif
+}
+
+void
+HardDrive::validateImage()
+{
+#ifndef _WIN32
+
+    if (!image) return;
+
+    /* A private mapping reflects changes made to the file by other processes.
+     * If the file has been truncated, accessing the cut-off part even raises
+     * SIGBUS. Hence, the drive switches to a private copy once the file has
+     * been modified. If the path refers to another file now, the mapped file
+     * has been deleted or replaced which leaves the mapping intact.
+     */
+    struct stat st;
+    FileStamp current;
+
+    if (::stat(imagePath.c_str(), &st) != 0 ||
+        !getFileStamp(st, current.size, current.mtime, current.inode) ||
+        current.inode != imageStamp.inode) {
+
+        detachImage(imageSize);
+
+    } else if (current != imageStamp) {
+
+        warn("%s has been modified externally\n", imagePath.c_str());
+        detachImage(std::min(current.size, imageSize));
+    }
+
+#endif
+}
+
+void
+HardDrive::detachImage(isize valid)
+{
+    assert(image);
+
+    debug(HDR_DEBUG, "Detaching from %s\n", imagePath.c_str());
+
+    data.init(imageSize);
+
+    for (isize nr = 0; nr < imageSize / 512; nr++) {
+
+        auto *dst = data.ptr + 512 * nr;
+
+        if (auto it = overlay.find(nr); it != overlay.end()) {
+
+            std::memcpy(dst, it->second.data(), 512);
+
+        } else {
+
+            // Blocks beyond the end of a truncated file are zeroed out
+            auto len = std::clamp(valid - 512 * nr, isize(0), isize(512));
+            std::memcpy(dst, image.get() + 512 * nr, len);
+            std::memset(dst + len, 0, 512 - len);
+        }
+    }
+
+    image = nullptr;
+    imageSize = 0;
+    imagePath.clear();
+    imageStamp = { };
+    overlay.clear();
+    touch();
+}
+
 void
 HardDrive::scheduleIdleEvent()
 {
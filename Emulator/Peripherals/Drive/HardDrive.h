@@ -15,6 +15,9 @@
 #include "HdControllerTypes.h"
 #include "HDFFile.h"
 #include "MemUtils.h"
+#include <array>
+#include <memory>
+#include <unordered_map>
 
 namespace vamiga {
 
@@ -57,6 +60,7 @@ class HardDrive : public Drive, public Inspectable<HardDriveInfo> {
     
     friend class HDFFile;
     friend class HdController;
+    friend class Rewinder;
 
     // Write-through storage files
     static std::fstream wtStream[4];
@@ -83,9 +87,44 @@ class HardDrive : public Drive, public Inspectable<HardDriveInfo> {
 
     // Disk data
     Buffer<u8> data;
+
+    /* Memory-mapped disk data. If the drive has been created from an HDF file,
+     * the file is mapped read-only and 'data' stays empty. The mapping is
+     * shared with the run-ahead instance. Blocks written by the Amiga are
+     * copied into a private overlay which takes precedence over the mapping.
+     */
+    std::shared_ptr<const u8> image;
+    isize imageSize = 0;
+    std::unordered_map<isize, std::array<u8, 512>> overlay;
+
+    /* Identity of the mapped file. If the file is modified by another
+     * process, the drive switches over to a private copy of the disk data.
+     */
+    struct FileStamp {
+
+        isize size = 0;
+        i64 mtime = 0;
+        u64 inode = 0;
+
+        bool operator==(const FileStamp &) const = default;
+    };
+    std::filesystem::path imagePath;
+    FileStamp imageStamp;
     
-    // Keeps track of modified blocks (to update the run-ahead instance)
-    Buffer<bool> dirty;
+    /* Modification stamps (to update the run-ahead instance). Whenever a
+     * block is modified, it is assigned a new, globally unique stamp. When a
+     * drive is cloned, only those blocks are copied whose stamps differ.
+     */
+    Buffer<u32> stamps;
+
+    /* Most recently assigned stamp. If two drives share this value, none of
+     * them has been modified since the latest clone and the block-wise
+     * comparison can be skipped.
+     */
+    u32 stamp = 0;
+
+    // Stamp counter (shared by all drives)
+    static std::atomic<u32> stampCounter;
 
     // Current position of the read/write head
     DriveHead head;
@@ -97,6 +136,9 @@ class HardDrive : public Drive, public Inspectable<HardDriveInfo> {
     DiskFlags flags = 0;
     optional <bool> bootable;
 
+    // Number of bytes copied by the latest clone
+    isize clonedBytes = 0;
+
     
     //
     // Initializing
@@ -155,6 +197,14 @@ public:
         return traits;
     }
 
+private:
+
+    // Creates a hard drive which is optionally backed by a memory-mapped image
+    void init(const GeometryDescriptor &geometry, std::shared_ptr<const u8> mapping, isize size);
+    void init(const HDFFile &hdf, std::shared_ptr<const u8> mapping, isize size) throws;
+
+public:
+
     const PartitionTraits &getPartitionTraits(isize nr) const {
 
         static PartitionTraits traits;
@@ -218,13 +268,47 @@ private:
         << controllerRevision
         << geometry
         << ptable
-        << drivers
-        << data
+        << drivers;
+
+        serializeData(worker);
+
+        worker
+
         << flags
         << bootable;
 
     } SERIALIZERS(serialize);
 
+    template <class T>
+    void serializeData(T& worker)
+    {
+        // The rewinder tracks the disk data by stamp
+        if (skipsBulkData(worker)) return;
+
+        /* Memory-mapped drives are serialized as if the merged image was
+         * stored in 'data'. The image is streamed block by block to avoid
+         * creating a temporary copy of the whole disk. When a snapshot is
+         * restored, the mapping is kept and only the blocks differing from
+         * the mapped file are recreated in the overlay.
+         */
+        validateImage();
+
+        if (image) {
+
+            auto stream = ByteStream {
+
+                .size   = geometry.numBytes(),
+                .source = [this](u8 *dst, isize offset, isize len) { copy(dst, offset, len); },
+                .sink   = [this](const u8 *src, isize len) { restoreImage(src, len); }
+            };
+
+            worker << stream;
+            return;
+        }
+
+        worker << data;
+    }
+
     void _didReset(bool hard) override;
     void _didLoad() override;
 
@@ -310,6 +394,9 @@ public:
     bool isModified() const { return flags & FLAG_MODIFIED; }
     void setModified(bool value) { value ? flags |= FLAG_MODIFIED : flags &= ~FLAG_MODIFIED; }
 
+    // Returns the number of bytes copied by the latest clone
+    isize getClonedBytes() const { return clonedBytes; }
+
     // Returns the current controller state
     HdcState getHdcState() const;
 
@@ -346,15 +433,35 @@ public:
     
     // Reads a loadable file system
     void readDriver(isize nr, Buffer<u8> &driver);
+
+    // Copies a range of bytes into a buffer (merging in the overlay)
+    void copy(u8 *buf, isize offset, isize len) const;
+
+    // Computes a checksum of the disk data (merging in the overlay)
+    u64 fnv64() const;
     
 private:
 
+    // Returns a pointer to a 512 byte block for reading or writing
+    const u8 *blockPtr(isize nr) const;
+    u8 *writableBlockPtr(isize nr);
+
+    // Overwrites a block (the overlay only keeps blocks differing from the file)
+    void importBlock(isize nr, const u8 *src);
+
+    // Restores the disk data of a memory-mapped drive from a snapshot
+    void restoreImage(const u8 *src, isize len);
+
     // Checks the given argument list for consistency
     i8 verify(isize offset, isize length, u32 addr);
 
     // Moves the drive head to the specified block
     void moveHead(isize lba);
     void moveHead(isize c, isize h, isize s);
+
+    // Assigns new modification stamps to a range of bytes or the entire disk
+    void touch(isize offset, isize length);
+    void touch() { touch(0, geometry.numBytes()); }
     
     
     //
@@ -369,10 +476,24 @@ public:
     // Exports the disk in HDF format
     void writeToFile(const std::filesystem::path &path) throws;
 
+private:
+
+    // Maps a file into memory (returns nullptr on failure)
+    static std::shared_ptr<const u8> mapFile(const std::filesystem::path &path,
+                                             isize size, FileStamp &stamp);
+
+    // Switches to a private copy if the mapped file has been modified
+    void validateImage();
+
+    // Replaces the mapping by a private copy (reading 'valid' mapped bytes)
+    void detachImage(isize valid);
+
     
     //
     // Managing write-through mode
     //
+
+public:
     
     void enableWriteThrough() throws;
     void disableWriteThrough();
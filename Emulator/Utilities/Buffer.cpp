@@ -23,7 +23,7 @@ Allocator<T>::operator= (const Allocator<T>& other)
     assert(size == other.size);
 
     // Copy buffer
-    if (size) memcpy(ptr, other.ptr, size);
+    if (size) memcpy(ptr, other.ptr, bytesize());
     return *this;
 }
 
@@ -183,12 +183,7 @@ Allocator<T>::copy(T *buf, isize offset, isize len) const
     assert((size == 0) == (ptr == nullptr));
     assert(offset >= 0 && len >= 0 && offset + len <= size);
     
-    if (ptr) {
-        
-        for (isize i = 0; i < len; i++) {
-            buf[i] = ptr[i + offset];
-        }
-    }
+    if (ptr) std::copy(ptr + offset, ptr + offset + len, buf);
 }
 
 template <class T> void
@@ -0,0 +1,134 @@
+// -----------------------------------------------------------------------------
+// This file is part of vAmiga
+//
+// Copyright (C) Dirk W. Hoffmann. www.dirkwhoffmann.de
+// Licensed under the Mozilla Public License v2
+//
+// See https://mozilla.org/MPL/2.0 for license information
+// -----------------------------------------------------------------------------
+
+#include "config.h"
+#include "Compression.h"
+#include <cstring>
+#include <vector>
+
+namespace vamiga::util {
+
+isize
+compress(const u8 *src, isize len, u8 *dst)
+{
+    constexpr isize hashBits = 14;
+    constexpr isize minMatch = 4;
+    constexpr isize window = 0xFFFF;
+
+    // Maps a hash of four consecutive bytes to the latest matching position
+    std::vector<isize> table(1 << hashBits, -1);
+
+    auto *out = dst;
+    isize anchor = 0;
+    isize i = 0;
+
+    // Emits all pending literals up to the specified position
+    auto flush = [&](isize end) {
+
+        while (anchor < end) {
+
+            auto n = std::min(end - anchor, isize(128));
+            *out++ = u8(n - 1);
+            std::memcpy(out, src + anchor, n);
+            out += n;
+            anchor += n;
+        }
+    };
+
+    while (i + minMatch <= len) {
+
+        u32 seq; std::memcpy(&seq, src + i, 4);
+        auto h = (seq * 2654435761U) >> (32 - hashBits);
+        auto ref = table[h];
+        table[h] = i;
+
+        if (ref < 0 || i - ref > window || std::memcmp(src + ref, src + i, 4)) {
+            i++;
+            continue;
+        }
+
+        // Extend the match
+        isize n = minMatch;
+        while (i + n < len && src[ref + n] == src[i + n]) n++;
+
+        // Emit the pending literals and the back reference
+        flush(i);
+
+        auto m = n - minMatch;
+        if (m < 0x7F) {
+            *out++ = u8(0x80 | m);
+        } else {
+            *out++ = 0xFF;
+            for (m -= 0x7F; m >= 0xFF; m -= 0xFF) *out++ = 0xFF;
+            *out++ = u8(m);
+        }
+        *out++ = u8((i - ref) >> 8);
+        *out++ = u8(i - ref);
+
+        i += n;
+        anchor = i;
+    }
+
+    flush(len);
+    return isize(out - dst);
+}
+
+isize
+decompress(const u8 *src, isize len, u8 *dst, isize capacity)
+{
+    auto *end = src + len;
+    auto *out = dst;
+    auto *outEnd = dst + capacity;
+
+    while (src < end) {
+
+        u8 c = *src++;
+
+        if (c < 0x80) {
+
+            // Literal run
+            isize n = c + 1;
+            if (end - src < n || outEnd - out < n) return -1;
+
+            std::memcpy(out, src, n);
+            src += n;
+            out += n;
+
+        } else {
+
+            // Back reference
+            isize n = c & 0x7F;
+            if (n == 0x7F) {
+
+                u8 b;
+                do {
+                    if (src == end) return -1;
+                    b = *src++;
+                    n += b;
+                } while (b == 0xFF);
+            }
+            n += 4;
+
+            if (end - src < 2) return -1;
+            isize offset = src[0] << 8 | src[1];
+            src += 2;
+
+            if (offset == 0 || offset > out - dst || outEnd - out < n) return -1;
+
+            // Copy byte by byte, because source and target may overlap
+            auto *ref = out - offset;
+            for (isize k = 0; k < n; k++) out[k] = ref[k];
+            out += n;
+        }
+    }
+
+    return isize(out - dst);
+}
+
+}
@@ -0,0 +1,39 @@
+// -----------------------------------------------------------------------------
+// This file is part of vAmiga
+//
+// Copyright (C) Dirk W. Hoffmann. www.dirkwhoffmann.de
+// Licensed under the Mozilla Public License v2
+//
+// See https://mozilla.org/MPL/2.0 for license information
+// -----------------------------------------------------------------------------
+
+#pragma once
+
+#include "BasicTypes.h"
+
+namespace vamiga::util {
+
+/* A lightweight LZ77 codec. The compressed stream is a sequence of tokens.
+ * Each token starts with a control byte c:
+ *
+ *   c < 0x80 : A literal run of c + 1 bytes follows.
+ *   c >= 0x80 : A back reference. The match length is (c & 0x7F) + 4. If the
+ *               lower bits are all set, the length is extended by the sum of
+ *               the subsequent bytes up to and including the first byte that
+ *               differs from 0xFF. The token ends with a 16-bit big endian
+ *               offset into the already decoded data.
+ *
+ * Back references may overlap with the bytes being decoded, which turns long
+ * runs of identical bytes into a few bytes of output.
+ */
+
+// Returns an upper bound for the size of the compressed data
+inline isize maxCompressedSize(isize len) { return len + len / 128 + 16; }
+
+// Compresses a memory block (returns the number of written bytes)
+isize compress(const u8 *src, isize len, u8 *dst);
+
+// Decompresses a memory block (returns -1 if the data is corrupted)
+isize decompress(const u8 *src, isize len, u8 *dst, isize capacity);
+
+}
@@ -10,6 +10,7 @@
 #pragma once
 
 #include "BasicTypes.h"
+#include <algorithm>
 #include <utility>
 #include <vector>
 
@@ -230,6 +231,17 @@ template <class T, isize capacity> struct RingBuffer
         elements[w] = element;
         w = next(w);
     }
+
+    void write(const T *buffer, isize n)
+    {
+        assert(n <= free());
+
+        // Copy the elements in at most two chunks
+        auto n1 = std::min(n, capacity - w);
+        std::copy(buffer, buffer + n1, elements + w);
+        std::copy(buffer + n1, buffer + n, elements);
+        w = (w + n) % capacity;
+    }
     
     void skip()
     {
@@ -1332,6 +1332,7 @@ RecorderAPI::getConfig() const
 {
     return recorder->getConfig();
 }
+*/
 
 const RecorderInfo &
 RecorderAPI::getInfo() const
@@ -1344,7 +1345,12 @@ RecorderAPI::getCachedInfo() const
 {
     return recorder->getCachedInfo();
 }
-*/
+
+const RecorderStats &
+RecorderAPI::getStats() const
+{
+    return recorder->getStats();
+}
 
 double RecorderAPI::getDuration() const { return recorder->getDuration().asSeconds(); }
 isize RecorderAPI::getFrameRate() const { return recorder->getFrameRate(); }
@@ -1898,12 +1904,24 @@ AmigaAPI::takeSnapshot()
     return amiga->takeSnapshot();
 }
 
+void
+AmigaAPI::saveSnapshot(const std::filesystem::path &path)
+{
+    amiga->saveSnapshot(path);
+}
+
 void 
 AmigaAPI::loadSnapshot(const MediaFile &snapshot)
 {
     amiga->loadSnapshot(snapshot);
     emu->isDirty = true;
 }
+
+isize
+AmigaAPI::rewind(isize frames)
+{
+    return emu->rewind(frames);
+}
     
 u64
 AmigaAPI::getAutoInspectionMask() const
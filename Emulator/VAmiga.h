@@ -90,12 +90,32 @@ struct AmigaAPI : public API {
      */
     MediaFile *takeSnapshot();
 
+    /** @brief  Writes a snapshot into a file
+     *
+     *  The snapshot is written in compressed format. In contrast to
+     *  takeSnapshot(), the state is streamed into the file component by
+     *  component without creating an in-memory copy first.
+     *
+     *  @param  path        Path to the snapshot file.
+     */
+    void saveSnapshot(const std::filesystem::path &path);
+
     /** @brief  Loads a snapshot into the emulator.
      *
      *  @param  snapshot    Reference to a snapshot.
      */
     void loadSnapshot(const MediaFile &snapshot);
 
+    /** @brief  Steps back in time.
+     *
+     *  Restores a state from the rewind buffer. The buffer is only filled if
+     *  option OPT_AMIGA_REWIND is set to a non-zero value.
+     *
+     *  @param  frames      Number of frames to step back.
+     *  @return Number of frames that have actually been stepped back.
+     */
+    isize rewind(isize frames = 1);
+
     /// @}
     /// @name Auto-inspecting components
     /// @{
@@ -1352,8 +1372,15 @@ struct RecorderAPI : public API {
 
     /** @brief  Returns the component's current state.
      */
-    // const RecorderInfo &getInfo() const;
-    // const RecorderInfo &getCachedInfo() const;
+    const RecorderInfo &getInfo() const;
+    const RecorderInfo &getCachedInfo() const;
+
+    /** @brief  Returns statistical information about the components.
+     *
+     *  The statistics reveal the fill level of the frame queue, the number of
+     *  dropped frames, and the time it takes to hand a frame over to FFmpeg.
+     */
+    const RecorderStats &getStats() const;
 
     const std::vector<std::filesystem::path> &paths() const;
     bool hasFFmpeg() const;
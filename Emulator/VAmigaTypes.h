@@ -49,6 +49,7 @@
 #include "RomFileTypes.h"
 
 // Miscellaneous
+#include "RecorderTypes.h"
 #include "RemoteManagerTypes.h"
 #include "RemoteServerTypes.h"
 #include "RetroShellTypes.h"
@@ -50,6 +50,7 @@ debugflag NTSC_DEBUG      = 0;
 debugflag COP_CHECKSUM    = 0;
 debugflag COPREG_DEBUG    = 0;
 debugflag COP_DEBUG       = 0;
+debugflag COP_ON_STEROIDS = 0;
 
 // Blitter
 debugflag BLT_CHECKSUM    = 0;
@@ -22,7 +22,7 @@
 // Snapshot version number
 #define SNP_MAJOR 2
 #define SNP_MINOR 6
-#define SNP_SUBMINOR 0
+#define SNP_SUBMINOR 1
 #define SNP_BETA 0
 
 // Uncomment this setting in a release build
@@ -107,6 +107,15 @@
 static const int DIAG_BOARD      = 0; // Plug in the diagnose board
 static const int ALLOW_ALL_ROMS  = 0; // Disable the magic bytes check
 
+/* Memory statistics. If set to 1, every CPU memory access is counted inside
+ * the memory accessors. If set to 0, the counters are compiled out of the
+ * accessors and the statistics are estimated once per rasterline instead.
+ * Headless batch builds may pass -DMEM_STATS=0 to the compiler.
+ */
+#ifndef MEM_STATS
+#define MEM_STATS 1
+#endif
+
 
 //
 // Debug settings
@@ -178,6 +187,7 @@ extern debugflag NTSC_DEBUG;
 extern debugflag COP_CHECKSUM;
 extern debugflag COPREG_DEBUG;
 extern debugflag COP_DEBUG;
+extern debugflag COP_ON_STEROIDS;
 
 // Blitter
 extern debugflag BLT_CHECKSUM;
@@ -342,10 +342,21 @@ extension MyController {
         let kickR = Float(mem.kickReads.accumulated) / max
         let kickW = Float(mem.kickWrites.accumulated) / max
         
-        addValues(Monitors.Monitor.chipRam, chipR, chipW)
-        addValues(Monitors.Monitor.slowRam, slowR, slowW)
-        addValues(Monitors.Monitor.fastRam, fastR, fastW)
-        addValues(Monitors.Monitor.kickRom, kickR, kickW)
+        if mem.sampled {
+
+            // Write accesses are not recorded if the statistics are sampled
+            addValue(Monitors.Monitor.chipRam, chipR)
+            addValue(Monitors.Monitor.slowRam, slowR)
+            addValue(Monitors.Monitor.fastRam, fastR)
+            addValue(Monitors.Monitor.kickRom, kickR)
+
+        } else {
+
+            addValues(Monitors.Monitor.chipRam, chipR, chipW)
+            addValues(Monitors.Monitor.slowRam, slowR, slowW)
+            addValues(Monitors.Monitor.fastRam, fastR, fastW)
+            addValues(Monitors.Monitor.kickRom, kickR, kickW)
+        }
     }
     
     func processMessage(_ msg: Message) {